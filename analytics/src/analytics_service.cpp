@@ -2,17 +2,30 @@
 #include "analytics_service.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using json = nlohmann::json;
 
+namespace {
+
+// How often the service thread logs the scoring pool stats
+constexpr auto kStatsInterval = std::chrono::seconds(60);
+
+// Price histories of mints without updates for this long are dropped
+constexpr auto kPriceHistoryIdle = std::chrono::hours(24);
+
+} // namespace
+
 AnalyticsService::AnalyticsService(const Config& config)
     : config_(config) {
     
     // Initialize components
     redis_bus_ = std::make_unique<RedisBus>(config_);
     pg_store_ = std::make_unique<PostgresStore>(config_);
+    token_list_ = std::make_unique<TokenListIndex>(config_);
+    price_history_ = std::make_unique<PriceHistory>(config_);
     signal_calculator_ = std::make_unique<SignalCalculator>(config_);
     confidence_scorer_ = std::make_unique<ConfidenceScorer>(config_);
     entry_checker_ = std::make_unique<EntryExitChecker>(config_);
@@ -27,7 +40,15 @@ AnalyticsService::AnalyticsService(const Config& config)
         *entry_checker_,
         *throttle_manager_,
         *regime_detector_,
-        *pg_store_
+        *pg_store_,
+        *token_list_,
+        *price_history_
+    );
+    
+    scoring_pool_ = std::make_unique<ScoringPool>(
+        static_cast<size_t>(std::max(1, config_.thread_pool_size)),
+        static_cast<size_t>(std::max(1, config_.scoring_max_pending_mints)),
+        [this](const MarketUpdate& update) { process_market_update(update); }
     );
 }
 
@@ -42,30 +63,52 @@ void AnalyticsService::run() {
     }
     
     running_ = true;
+    token_list_->start();
+    scoring_pool_->start();
     
     // Subscribe to market updates
-    redis_bus_->subscribe_market_updates([this](const MarketUpdate& update) {
-        // Queue the update for processing
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            update_queue_.push(update);
+    redis_bus_->subscribe_market_updates([this](const std::vector<MarketUpdate>& updates) {
+        // Load the batch's token metadata in one query before the workers need it
+        std::vector<std::string> mints;
+        mints.reserve(updates.size());
+        for (const auto& update : updates) {
+            mints.push_back(update.mint_base);
         }
-        queue_cv_.notify_one();
+        pg_store_->prefetch_token_metadata(mints);
         
-        // Track SOL price for regime detection
-        if (update.mint_base == config_.sol_mint) {
-            std::lock_guard<std::mutex> lock(sol_mutex_);
-            sol_price_ = update.price_usd;
+        auto max_age = std::chrono::seconds(config_.max_update_age_seconds);
+        auto now = std::chrono::system_clock::now();
+        for (const auto& update : updates) {
+            // Every price goes into the history, SOL's too: it is the
+            // relative-strength baseline. Scoring may coalesce updates, the
+            // history must not.
+            price_history_->update(update);
             
-            // Calculate 24h change if we have historical data
-            auto it = update.bars.find("15m");
-            if (it != update.bars.end()) {
-                const auto& bar_15m = it->second;
-                sol_24h_change_pct_ = ((bar_15m.close / bar_15m.open) - 1.0) * 100.0;
+            // The ingestor republishes its restored pools on a warm start,
+            // stamped with their last refresh; those are history, not a tick
+            // to score or to move the regime with
+            if (now - update.timestamp > max_age) {
+                continue;
             }
             
-            // Update risk regime
-            regime_detector_->update_regime(sol_price_, sol_24h_change_pct_);
+            // Queue the update for scoring on the worker pool
+            scoring_pool_->submit(update);
+            
+            // Track SOL price for regime detection
+            if (update.mint_base == config_.sol_mint) {
+                std::lock_guard<std::mutex> lock(sol_mutex_);
+                sol_price_ = update.price;
+                
+                // Calculate 24h change if we have historical data
+                auto it = update.bars.find("15m");
+                if (it != update.bars.end()) {
+                    const auto& bar_15m = it->second;
+                    sol_24h_change_pct_ = ((bar_15m.close / bar_15m.open) - 1.0) * 100.0;
+                }
+                
+                // Update risk regime
+                regime_detector_->update_regime(sol_price_, sol_24h_change_pct_);
+            }
         }
     });
     
@@ -74,7 +117,7 @@ void AnalyticsService::run() {
         handle_command_request(request);
     });
     
-    // Start service thread
+    // Start stats reporting thread
     service_thread_ = std::thread(&AnalyticsService::service_thread_func, this);
     
     spdlog::info("Analytics service started");
@@ -90,8 +133,9 @@ void AnalyticsService::stop() {
     // Stop Redis subscriptions
     redis_bus_->stop_subscribers();
     
-    // Notify queue processor to exit
-    queue_cv_.notify_all();
+    // In-flight updates finish; queued ones are dropped
+    scoring_pool_->stop();
+    token_list_->stop();
     
     // Wait for service thread to finish
     if (service_thread_.joinable()) {
@@ -104,41 +148,51 @@ void AnalyticsService::stop() {
 void AnalyticsService::service_thread_func() {
     spdlog::info("Analytics service thread started");
     
+    // The log reports each interval; the command's readings reset nothing
+    auto last_stats = scoring_pool_->stats();
+    auto next_report = std::chrono::steady_clock::now() + kStatsInterval;
     while (running_) {
-        MarketUpdate update;
-        bool has_update = false;
-        
-        // Get next update from queue
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (update_queue_.empty()) {
-                // Wait for new updates or stop signal
-                queue_cv_.wait_for(lock, std::chrono::seconds(1), [this] {
-                    return !running_ || !update_queue_.empty();
-                });
-                
-                if (!running_) {
-                    break;
-                }
-                
-                if (update_queue_.empty()) {
-                    continue;
-                }
-            }
-            
-            update = update_queue_.front();
-            update_queue_.pop();
-            has_update = true;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        if (std::chrono::steady_clock::now() < next_report) {
+            continue;
         }
+        next_report += kStatsInterval;
         
-        if (has_update) {
-            process_market_update(update);
-        }
+        auto stats = scoring_pool_->stats(last_stats);
+        spdlog::info("Scoring pool: {}", scoring_stats_json(stats).dump());
+        last_stats = std::move(stats);
+        
+        prune_watch_marks();
+        
+        size_t pruned = price_history_->prune(kPriceHistoryIdle);
+        spdlog::debug("Price history: {} mints, {} pruned", price_history_->size(), pruned);
     }
     
     spdlog::info("Analytics service thread stopped");
 }
 
+json AnalyticsService::scoring_stats_json(const ScoringPoolStats& stats) const {
+    json stages = json::object();
+    for (const auto& stage : stats.stages) {
+        stages[stage.stage] = {
+            {"count", stage.count},
+            {"avg_ms", stage.avg_ms},
+            {"max_ms", stage.max_ms}
+        };
+    }
+    
+    return {
+        {"queue_depth", stats.queue_depth},
+        {"active_mints", stats.active_mints},
+        {"processed", stats.processed},
+        {"coalesced", stats.coalesced},
+        {"dropped", stats.dropped},
+        {"stolen", stats.stolen},
+        {"worker_utilization", stats.worker_utilization},
+        {"stages", stages}
+    };
+}
+
 void AnalyticsService::process_market_update(const MarketUpdate& update) {
     try {
         // Skip SOL updates for signal processing (we only use SOL for regime detection)
@@ -149,14 +203,20 @@ void AnalyticsService::process_market_update(const MarketUpdate& update) {
         // Cache the market update
         api_signals_handler_->cache_market_update(update);
         
+        auto stage_start = std::chrono::steady_clock::now();
+        auto end_stage = [&](const char* stage) {
+            auto now = std::chrono::steady_clock::now();
+            scoring_pool_->record_stage(stage, now - stage_start);
+            stage_start = now;
+        };
+        
         // Get token metadata
         auto metadata = pg_store_->get_token_metadata(update.mint_base);
-        
-        // Get token list mints
-        auto token_list_mints = pg_store_->get_token_list_mints();
+        end_stage("lookup");
         
         // Calculate signals
-        SignalResult signals = signal_calculator_->calculate_signals(update, metadata, token_list_mints);
+        auto indicators = price_history_->indicators(update.mint_base);
+        SignalResult signals = signal_calculator_->calculate_signals(update, metadata, *token_list_, indicators);
         
         // Calculate confidence score
         signals.confidence_score = confidence_scorer_->calculate_confidence(signals);
@@ -174,15 +234,59 @@ void AnalyticsService::process_market_update(const MarketUpdate& update) {
         // Determine band
         signals.band = confidence_scorer_->determine_band(
             signals.confidence_score, signals.entry_confirmed, signals.net_edge_ok);
+        end_stage("scoring");
+        
+        // Candidates get fresher data from the ingestor while we watch them
+        update_watch_mark(update.mint_base, signals.band);
         
         // Generate alerts if needed
         generate_alerts(update, signals);
+        end_stage("alerts");
         
     } catch (const std::exception& e) {
         spdlog::error("Error processing market update: {}", e.what());
     }
 }
 
+void AnalyticsService::update_watch_mark(const std::string& mint, const std::string& band) {
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::seconds ttl = std::chrono::minutes(config_.watch_window_min);
+    
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        if (band == "watch") {
+            // The mark simply runs out; a later candidate band writes it again
+            watch_marks_.erase(mint);
+            return;
+        }
+        
+        // Only a band change, or a mark past half its window, costs a ZADD
+        auto it = watch_marks_.find(mint);
+        if (it != watch_marks_.end() && it->second.band == band && it->second.expiry - now > ttl / 2) {
+            return;
+        }
+        watch_marks_[mint] = WatchMark{band, now + ttl};
+    }
+    
+    if (!redis_bus_->mark_watched(mint, ttl)) {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watch_marks_.erase(mint);
+    }
+}
+
+void AnalyticsService::prune_watch_marks() {
+    auto now = std::chrono::steady_clock::now();
+    
+    std::lock_guard<std::mutex> lock(watch_mutex_);
+    for (auto it = watch_marks_.begin(); it != watch_marks_.end();) {
+        if (it->second.expiry <= now) {
+            it = watch_marks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void AnalyticsService::handle_command_request(const CommandRequest& request) {
     try {
         // Check if this is a signals request
@@ -192,6 +296,12 @@ void AnalyticsService::handle_command_request(const CommandRequest& request) {
             
             // Publish reply
             redis_bus_->publish_command_reply(reply);
+        } else if (request.command == "get_scoring_stats") {
+            CommandReply reply;
+            reply.corr_id = request.corr_id;
+            reply.status = "success";
+            reply.data = scoring_stats_json(scoring_pool_->stats()).dump();
+            redis_bus_->publish_command_reply(reply);
         }
     } catch (const std::exception& e) {
         spdlog::error("Error handling command request: {}", e.what());
@@ -211,6 +321,8 @@ void AnalyticsService::generate_alerts(const MarketUpdate& update, const SignalR
         return;
     }
     
+    std::lock_guard<std::mutex> lock(alert_mutex_);
+    
     // Check if we should throttle this alert
     if (throttle_manager_->should_throttle(update.mint_base, signals.band)) {
         return;
@@ -220,7 +332,7 @@ void AnalyticsService::generate_alerts(const MarketUpdate& update, const SignalR
     Alert alert;
     alert.mint = update.mint_base;
     alert.symbol = update.symbol_base;
-    alert.price_usd = update.price_usd;
+    alert.price_usd = update.price;
     alert.liq_usd = update.liq_usd;
     alert.vol24h_usd = update.vol24h_usd;
     alert.confidence_score = signals.confidence_score;
@@ -10,12 +10,16 @@
 #include "throttles.hpp"
 #include "regime.hpp"
 #include "api_signals.hpp"
+#include "scoring_pool.hpp"
+#include "token_list_index.hpp"
+#include "price_history.hpp"
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <unordered_map>
 #include <thread>
 #include <memory>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
 
 class AnalyticsService {
 public:
@@ -29,24 +33,35 @@ public:
     void stop();
 
 private:
-    // Service thread function
+    // Service thread function: reports scoring pool stats
     void service_thread_func();
     
-    // Process market updates
+    // Process market updates (runs on the scoring pool workers)
     void process_market_update(const MarketUpdate& update);
     
+    // Scoring pool stats as a JSON object
+    nlohmann::json scoring_stats_json(const ScoringPoolStats& stats) const;
+    
     // Handle command requests
     void handle_command_request(const CommandRequest& request);
     
     // Generate and publish alerts
     void generate_alerts(const MarketUpdate& update, const SignalResult& signals);
     
+    // Keep the ingestor's watch mark for a mint in step with its band
+    void update_watch_mark(const std::string& mint, const std::string& band);
+    
+    // Forget watch marks that have expired in Redis
+    void prune_watch_marks();
+    
     // Configuration
     Config config_;
     
     // Service components
     std::unique_ptr<RedisBus> redis_bus_;
     std::unique_ptr<PostgresStore> pg_store_;
+    std::unique_ptr<TokenListIndex> token_list_;
+    std::unique_ptr<PriceHistory> price_history_;
     std::unique_ptr<SignalCalculator> signal_calculator_;
     std::unique_ptr<ConfidenceScorer> confidence_scorer_;
     std::unique_ptr<EntryExitChecker> entry_checker_;
@@ -58,10 +73,19 @@ private:
     std::atomic<bool> running_{false};
     std::thread service_thread_;
     
-    // Market update queue
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::queue<MarketUpdate> update_queue_;
+    // Market updates are scored on a worker pool, in order per mint
+    std::unique_ptr<ScoringPool> scoring_pool_;
+    
+    // Throttle check and record must not interleave across workers
+    std::mutex alert_mutex_;
+    
+    // Watch marks written to Redis: band and expiry of the last write, per mint
+    struct WatchMark {
+        std::string band;
+        std::chrono::steady_clock::time_point expiry;
+    };
+    std::unordered_map<std::string, WatchMark> watch_marks_;
+    std::mutex watch_mutex_;
     
     // SOL price tracking
     double sol_price_{0.0};
@@ -13,14 +13,18 @@ ApiSignalsHandler::ApiSignalsHandler(
     EntryExitChecker& entry_checker,
     ThrottleManager& throttle_manager,
     RegimeDetector& regime_detector,
-    PostgresStore& pg_store
+    PostgresStore& pg_store,
+    const TokenListIndex& token_list,
+    const PriceHistory& price_history
 ) : config_(config),
     signal_calculator_(signal_calculator),
     confidence_scorer_(confidence_scorer),
     entry_checker_(entry_checker),
     throttle_manager_(throttle_manager),
     regime_detector_(regime_detector),
-    pg_store_(pg_store) {}
+    pg_store_(pg_store),
+    token_list_(token_list),
+    price_history_(price_history) {}
 
 CommandReply ApiSignalsHandler::handle_signals_request(const CommandRequest& request) {
     CommandReply reply;
@@ -36,6 +40,19 @@ CommandReply ApiSignalsHandler::handle_signals_request(const CommandRequest& req
             auto signals_opt = get_token_signals(mint);
             
             if (signals_opt) {
+                auto indicators = price_history_.indicators(mint);
+                auto window_json = [](const WindowStats& window) {
+                    return json{
+                        {"ready", window.ready},
+                        {"bars", window.bars},
+                        {"return_pct", window.return_pct},
+                        {"high", window.high},
+                        {"low", window.low},
+                        {"atr_pct", window.atr_pct},
+                        {"realized_vol_pct", window.realized_vol_pct}
+                    };
+                };
+                
                 json result = {
                     {"mint", mint},
                     {"confidence", signals_opt->confidence_score},
@@ -53,11 +70,16 @@ CommandReply ApiSignalsHandler::handle_signals_request(const CommandRequest& req
                         {"s10_route_quality", signals_opt->s10_route_quality},
                         {"n1_hygiene", signals_opt->n1_hygiene}
                     }},
+                    {"indicators", {
+                        {"1h", window_json(indicators.h1)},
+                        {"24h", window_json(indicators.h24)}
+                    }},
                     {"data_quality", signals_opt->data_quality},
                     {"entry_confirmed", signals_opt->entry_confirmed},
                     {"net_edge_ok", signals_opt->net_edge_ok},
                     {"reasons", signals_opt->reasons},
-                    {"risk_regime", regime_detector_.get_regime_string()}
+                    {"risk_regime", regime_detector_.get_regime_string()},
+                    {"sol_realized_vol_pct", regime_detector_.sol_realized_vol_pct()}
                 };
                 
                 reply.data = result.dump();
@@ -121,11 +143,9 @@ std::optional<SignalResult> ApiSignalsHandler::get_token_signals(const std::stri
     // Get token metadata
     auto metadata = pg_store_.get_token_metadata(mint);
     
-    // Get token list mints
-    auto token_list_mints = pg_store_.get_token_list_mints();
-    
-    // Calculate signals
-    SignalResult signals = signal_calculator_.calculate_signals(*update_opt, metadata, token_list_mints);
+    // Calculate signals from the windows as of the mint's last scored update
+    auto indicators = price_history_.indicators(mint);
+    SignalResult signals = signal_calculator_.calculate_signals(*update_opt, metadata, token_list_, indicators);
     
     // Calculate confidence score
     signals.confidence_score = confidence_scorer_.calculate_confidence(signals);
@@ -172,7 +192,7 @@ std::vector<PortfolioSignalResult> ApiSignalsHandler::get_portfolio_signals(cons
         // Get current price and calculate PnL
         auto update_opt = get_cached_update(holding.mint);
         if (update_opt) {
-            result.current_price = update_opt->price_usd;
+            result.current_price = update_opt->price;
             result.pnl_pct = ((result.current_price / result.entry_price) - 1.0) * 100.0;
             
             // Calculate hold time
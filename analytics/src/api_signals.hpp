@@ -8,6 +8,8 @@
 #include "throttles.hpp"
 #include "regime.hpp"
 #include "pg_store.hpp"
+#include "token_list_index.hpp"
+#include "price_history.hpp"
 #include <string>
 #include <optional>
 #include <mutex>
@@ -22,7 +24,9 @@ public:
         EntryExitChecker& entry_checker,
         ThrottleManager& throttle_manager,
         RegimeDetector& regime_detector,
-        PostgresStore& pg_store
+        PostgresStore& pg_store,
+        const TokenListIndex& token_list,
+        const PriceHistory& price_history
     );
     
     // Handle a signals request
@@ -48,6 +52,8 @@ private:
     ThrottleManager& throttle_manager_;
     RegimeDetector& regime_detector_;
     PostgresStore& pg_store_;
+    const TokenListIndex& token_list_;
+    const PriceHistory& price_history_;
     
     std::mutex cache_mutex_;
     std::unordered_map<std::string, MarketUpdate> market_updates_cache_;
@@ -1,6 +1,8 @@
 
 #include "config.hpp"
+#include <algorithm>
 #include <cstdlib>
+#include <stdexcept>
 #include <spdlog/spdlog.h>
 
 namespace {
@@ -41,6 +43,9 @@ void Config::load_from_env() {
     stream_alerts = get_env("STREAM_ALERTS", stream_alerts);
     stream_req = get_env("STREAM_REQ", stream_req);
     stream_rep = get_env("STREAM_REP", stream_rep);
+    watchlist_key = get_env("WATCHLIST_KEY", watchlist_key);
+    stream_batch_size = std::max(1, get_env_int("STREAM_BATCH_SIZE", stream_batch_size));
+    stream_block_ms = std::max(1, get_env_int("STREAM_BLOCK_MS", stream_block_ms));
     
     // PostgreSQL configuration
     pg_dsn = get_env("PG_DSN", pg_dsn);
@@ -55,9 +60,88 @@ void Config::load_from_env() {
     watch_window_min = get_env_int("WATCH_WINDOW_MIN", watch_window_min);
     reentry_guard_hours = get_env_int("REENTRY_GUARD_HOURS", reentry_guard_hours);
     
+    // Alert throttling; the minute cooldowns default to the hour settings
+    cooldown_high_conviction_min = get_env_int("COOLDOWN_HIGH_CONVICTION_MIN", cooldown_actionable_hours * 60);
+    cooldown_actionable_min = get_env_int("COOLDOWN_ACTIONABLE_MIN", cooldown_actionable_hours * 60);
+    cooldown_headsup_min = get_env_int("COOLDOWN_HEADSUP_MIN", cooldown_headsup_hours * 60);
+    cooldown_watch_min = get_env_int("COOLDOWN_WATCH_MIN", cooldown_watch_min);
+    rate_limit_window_min = std::max(1, get_env_int("RATE_LIMIT_WINDOW_MIN", rate_limit_window_min));
+    max_alerts_per_window = get_env_int("MAX_ALERTS_PER_WINDOW", max_alerts_per_window);
+    max_high_conviction_per_window = get_env_int("MAX_HIGH_CONVICTION_PER_WINDOW", max_high_conviction_per_window);
+    max_actionable_per_window = get_env_int("MAX_ACTIONABLE_PER_WINDOW", max_actionable_per_window);
+    max_headsup_per_window = get_env_int("MAX_HEADSUP_PER_WINDOW", max_headsup_per_window);
+    max_watch_per_window = get_env_int("MAX_WATCH_PER_WINDOW", max_watch_per_window);
+    throttle_state_file = get_env("THROTTLE_STATE_FILE", throttle_state_file);
+    
     // Service configuration
     service_name = get_env("SERVICE_NAME", service_name);
     listen_addr = get_env("LISTEN_ADDR", listen_addr);
     listen_port = get_env_int("LISTEN_PORT", listen_port);
     log_level = get_env("LOG_LEVEL", log_level);
+    
+    // Hard gates and momentum; these also place the signal curve breakpoints
+    min_liquidity_actionable = get_env_double("MIN_LIQUIDITY_ACTIONABLE", min_liquidity_actionable);
+    min_liquidity_headsup = get_env_double("MIN_LIQUIDITY_HEADSUP", min_liquidity_headsup);
+    min_volume_actionable = get_env_double("MIN_VOLUME_ACTIONABLE", min_volume_actionable);
+    min_volume_headsup = get_env_double("MIN_VOLUME_HEADSUP", min_volume_headsup);
+    max_impact_pct = get_env_double("MAX_IMPACT_PCT", max_impact_pct);
+    max_spread_pct = get_env_double("MAX_SPREAD_PCT", max_spread_pct);
+    max_route_hops = get_env_int("MAX_ROUTE_HOPS", max_route_hops);
+    max_route_deviation = get_env_double("MAX_ROUTE_DEVIATION", max_route_deviation);
+    min_m1h_pct = get_env_double("MIN_M1H_PCT", min_m1h_pct);
+    max_m1h_pct = get_env_double("MAX_M1H_PCT", max_m1h_pct);
+    min_m24h_pct = get_env_double("MIN_M24H_PCT", min_m24h_pct);
+    max_m24h_pct = get_env_double("MAX_M24H_PCT", max_m24h_pct);
+    dq_start = get_env_double("DQ_START", dq_start);
+    dq_penalty_per_missing = get_env_double("DQ_PENALTY_PER_MISSING", dq_penalty_per_missing);
+    
+    // Market reference
+    sol_mint = get_env("SOL_MINT", sol_mint);
+    
+    // Risk regime
+    risk_on_sol_change_threshold = get_env_double("RISK_ON_SOL_CHANGE_THRESHOLD", risk_on_sol_change_threshold);
+    risk_on_momentum_threshold = get_env_double("RISK_ON_MOMENTUM_THRESHOLD", risk_on_momentum_threshold);
+    regime_max_sol_vol_pct = get_env_double("REGIME_MAX_SOL_VOL_PCT", regime_max_sol_vol_pct);
+    
+    // Token list hygiene
+    token_list_refresh_seconds = get_env_int("TOKEN_LIST_REFRESH_SECONDS", token_list_refresh_seconds);
+    
+    // Token metadata cache
+    metadata_ttl_seconds = get_env_int("METADATA_TTL_SECONDS", metadata_ttl_seconds);
+    metadata_stale_seconds = get_env_int("METADATA_STALE_SECONDS", metadata_stale_seconds);
+    metadata_negative_ttl_seconds = get_env_int("METADATA_NEGATIVE_TTL_SECONDS", metadata_negative_ttl_seconds);
+    
+    // Thread pool
+    thread_pool_size = get_env_int("THREAD_POOL_SIZE", thread_pool_size);
+    scoring_max_pending_mints = get_env_int("SCORING_MAX_PENDING_MINTS", scoring_max_pending_mints);
+    max_update_age_seconds = get_env_int("MAX_UPDATE_AGE_SECONDS", max_update_age_seconds);
+    
+    validate();
+}
+
+void Config::validate() const {
+    auto require_order = [](const char* lower_name, double lower, const char* upper_name, double upper) {
+        if (lower > upper) {
+            throw std::invalid_argument(fmt::format("{} ({}) must not exceed {} ({})",
+                                                    lower_name, lower, upper_name, upper));
+        }
+    };
+    auto require_non_negative = [](const char* name, double value) {
+        if (value < 0.0) {
+            throw std::invalid_argument(fmt::format("{} ({}) must not be negative", name, value));
+        }
+    };
+    
+    require_non_negative("MIN_LIQUIDITY_HEADSUP", min_liquidity_headsup);
+    require_order("MIN_LIQUIDITY_HEADSUP", min_liquidity_headsup, "MIN_LIQUIDITY_ACTIONABLE", min_liquidity_actionable);
+    require_non_negative("MIN_VOLUME_HEADSUP", min_volume_headsup);
+    require_order("MIN_VOLUME_HEADSUP", min_volume_headsup, "MIN_VOLUME_ACTIONABLE", min_volume_actionable);
+    require_order("MIN_M1H_PCT", min_m1h_pct, "MAX_M1H_PCT", max_m1h_pct);
+    require_order("MIN_M24H_PCT", min_m24h_pct, "MAX_M24H_PCT", max_m24h_pct);
+    require_non_negative("MAX_SPREAD_PCT", max_spread_pct);
+    require_non_negative("MAX_IMPACT_PCT", max_impact_pct);
+    if (max_route_hops < 1) {
+        throw std::invalid_argument(fmt::format("MAX_ROUTE_HOPS ({}) must be at least 1", max_route_hops));
+    }
+    require_non_negative("MAX_ROUTE_DEVIATION", max_route_deviation);
 }
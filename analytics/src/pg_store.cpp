@@ -1,17 +1,36 @@
 #include "pg_store.hpp"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <thread>
+#include <unordered_set>
+
+namespace {
+
+// The refresher also evicts entries past their stale window this often
+constexpr auto kEvictInterval = std::chrono::seconds(60);
+
+} // namespace
 
 class PostgresStore::Impl {
 public:
     Impl(const Config& config) 
         : config_(config), backoff_ms_(1000), retry_count_(0) {
         connect();
+        refresh_thread_ = std::thread(&Impl::refresh_loop, this);
     }
 
     ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(metadata_mutex_);
+            running_ = false;
+        }
+        refresh_cv_.notify_all();
+        if (refresh_thread_.joinable()) {
+            refresh_thread_.join();
+        }
         disconnect();
     }
 
@@ -85,6 +104,7 @@ public:
             }
         }
         
+        std::lock_guard<std::mutex> db_lock(db_mutex_);
         if (!ensure_connection()) {
             return std::nullopt;
         }
@@ -150,18 +170,97 @@ public:
     }
 
     std::optional<TokenMetadata> get_token_metadata(const std::string& mint) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(metadata_mutex_);
+            auto it = metadata_cache_.find(mint);
+            if (it != metadata_cache_.end()) {
+                auto age = std::chrono::steady_clock::now() - it->second.fetched_at;
+                auto ttl = ttl_for(it->second);
+                if (age < ttl) {
+                    return it->second.metadata;
+                }
         
-        // Check cache first
-        auto cache_it = token_cache_.find(mint);
-        if (cache_it != token_cache_.end()) {
-            auto now = std::chrono::system_clock::now();
-            if (std::chrono::duration_cast<std::chrono::minutes>(
-                    now - cache_it->second.first_liquidity_ts).count() < 30) {
-                return cache_it->second;
+                // Serve the stale entry and let the refresher re-read it
+                if (age < ttl + std::chrono::seconds(config_.metadata_stale_seconds)) {
+                    if (!it->second.refreshing) {
+                        it->second.refreshing = true;
+                        refresh_queue_.push_back(mint);
+                        refresh_cv_.notify_one();
+                    }
+                    return it->second.metadata;
+                }
+            }
+        }
+        
+        // Miss: read through, without holding the cache lock during the query
+        std::vector<std::string> mints{mint};
+        auto found = fetch_token_metadata(mints);
+        if (!found) {
+            return std::nullopt;
+        }
+        store_token_metadata(mints, *found);
+        
+        auto it = found->find(mint);
+        if (it == found->end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    
+    void prefetch_token_metadata(const std::vector<std::string>& mints) {
+        std::vector<std::string> missing;
+        {
+            std::lock_guard<std::mutex> lock(metadata_mutex_);
+            auto now = std::chrono::steady_clock::now();
+            std::unordered_set<std::string> seen;
+            for (const auto& mint : mints) {
+                if (!seen.insert(mint).second) continue;
+                
+                auto it = metadata_cache_.find(mint);
+                if (it == metadata_cache_.end() ||
+                    (!it->second.refreshing && now - it->second.fetched_at >= ttl_for(it->second))) {
+                    missing.push_back(mint);
+                }
             }
         }
         
+        if (missing.empty()) {
+            return;
+        }
+        
+        auto found = fetch_token_metadata(missing);
+        if (found) {
+            store_token_metadata(missing, *found);
+        }
+    }
+    
+    void clear_caches() {
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            portfolio_cache_.clear();
+        }
+        
+        std::lock_guard<std::mutex> lock(metadata_mutex_);
+        metadata_cache_.clear();
+    }
+
+private:
+    // A cached lookup; metadata is empty for mints that are not in tokens
+    struct MetadataEntry {
+        std::optional<TokenMetadata> metadata;
+        std::chrono::steady_clock::time_point fetched_at;
+        bool refreshing = false;
+    };
+    
+    std::chrono::seconds ttl_for(const MetadataEntry& entry) const {
+        return std::chrono::seconds(entry.metadata ? config_.metadata_ttl_seconds
+                                                   : config_.metadata_negative_ttl_seconds);
+    }
+    
+    // One query for all the mints; empty when the database could not be read
+    std::optional<std::unordered_map<std::string, TokenMetadata>> fetch_token_metadata(
+            const std::vector<std::string>& mints) {
+        std::lock_guard<std::mutex> lock(db_mutex_);
         if (!ensure_connection()) {
             return std::nullopt;
         }
@@ -170,74 +269,118 @@ public:
             pqxx::work txn(*conn_);
             
             pqxx::result result = txn.exec_params(
-                "SELECT t.symbol, t.name, t.decimals, t.on_token_list, "
+                "SELECT t.mint, t.symbol, t.name, t.decimals, t.on_token_list, "
                 "t.top_holder_pct, t.risky_authorities, t.first_liquidity_ts "
                 "FROM tokens t "
-                "WHERE t.mint = $1",
-                mint
+                "WHERE t.mint = ANY($1::text[])",
+                to_text_array(mints)
             );
             
-            if (result.empty()) {
-                return std::nullopt;
+            std::unordered_map<std::string, TokenMetadata> found;
+            for (const auto& row : result) {
+                TokenMetadata metadata;
+                metadata.mint = row["mint"].as<std::string>();
+                metadata.symbol = row["symbol"].as<std::string>();
+                metadata.name = row["name"].as<std::string>();
+                metadata.decimals = row["decimals"].as<int>();
+                metadata.on_token_list = row["on_token_list"].as<bool>();
+                metadata.top_holder_pct = row["top_holder_pct"].as<double>();
+                metadata.risky_authorities = row["risky_authorities"].as<bool>();
+                
+                // Parse timestamp
+                std::string ts_str = row["first_liquidity_ts"].as<std::string>();
+                metadata.first_liquidity_ts = parse_iso8601(ts_str);
+                
+                found[metadata.mint] = std::move(metadata);
             }
             
-            TokenMetadata metadata;
-            metadata.mint = mint;
-            metadata.symbol = result[0]["symbol"].as<std::string>();
-            metadata.name = result[0]["name"].as<std::string>();
-            metadata.decimals = result[0]["decimals"].as<int>();
-            metadata.on_token_list = result[0]["on_token_list"].as<bool>();
-            metadata.top_holder_pct = result[0]["top_holder_pct"].as<double>();
-            metadata.risky_authorities = result[0]["risky_authorities"].as<bool>();
-            
-            // Parse timestamp
-            std::string ts_str = result[0]["first_liquidity_ts"].as<std::string>();
-            metadata.first_liquidity_ts = parse_iso8601(ts_str);
-            
             txn.commit();
-            
-            // Update cache
-            token_cache_[mint] = metadata;
-            
-            return metadata;
+            return found;
         } catch (const std::exception& e) {
             spdlog::error("Error fetching token metadata: {}", e.what());
             return std::nullopt;
         }
     }
 
-    std::vector<std::string> get_token_list_mints() {
-        if (!ensure_connection()) {
-            return {};
+    // Caches every requested mint, negatively when the query did not return it
+    void store_token_metadata(const std::vector<std::string>& mints,
+                              const std::unordered_map<std::string, TokenMetadata>& found) {
+        std::lock_guard<std::mutex> lock(metadata_mutex_);
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& mint : mints) {
+            auto& entry = metadata_cache_[mint];
+            auto it = found.find(mint);
+            if (it != found.end()) {
+                entry.metadata = it->second;
+            } else {
+                entry.metadata.reset();
+            }
+            entry.fetched_at = now;
+            entry.refreshing = false;
         }
+    }
 
-        try {
-            pqxx::work txn(*conn_);
+    void refresh_loop() {
+        while (running_) {
+            std::vector<std::string> mints;
+            {
+                std::unique_lock<std::mutex> lock(metadata_mutex_);
+                refresh_cv_.wait_for(lock, kEvictInterval, [this] {
+                    return !running_ || !refresh_queue_.empty();
+                });
+                if (!running_) break;
+                
+                mints.swap(refresh_queue_);
+                evict_expired();
+            }
             
-            pqxx::result result = txn.exec(
-                "SELECT mint FROM tokens WHERE on_token_list = true"
-            );
+            if (mints.empty()) continue;
             
-            std::vector<std::string> mints;
-            for (const auto& row : result) {
-                mints.push_back(row["mint"].as<std::string>());
+            auto found = fetch_token_metadata(mints);
+            if (found) {
+                store_token_metadata(mints, *found);
+                continue;
             }
             
-            txn.commit();
-            return mints;
-        } catch (const std::exception& e) {
-            spdlog::error("Error fetching token list mints: {}", e.what());
-            return {};
+            // Keep serving the stale entries; the next lookup retries
+            std::lock_guard<std::mutex> lock(metadata_mutex_);
+            for (const auto& mint : mints) {
+                auto it = metadata_cache_.find(mint);
+                if (it != metadata_cache_.end()) {
+                    it->second.refreshing = false;
+                }
+            }
         }
     }
-
-    void clear_caches() {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        portfolio_cache_.clear();
-        token_cache_.clear();
+    
+    // Drops entries past their stale window; metadata_mutex_ must be held
+    void evict_expired() {
+        auto now = std::chrono::steady_clock::now();
+        auto stale = std::chrono::seconds(config_.metadata_stale_seconds);
+        for (auto it = metadata_cache_.begin(); it != metadata_cache_.end();) {
+            if (!it->second.refreshing && now - it->second.fetched_at >= ttl_for(it->second) + stale) {
+                it = metadata_cache_.erase(it);
+            } else {
+                ++it;
+            }
+        }
     }
-
-private:
+    
+    static std::string to_text_array(const std::vector<std::string>& values) {
+        std::string array = "{";
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) array += ',';
+            array += '"';
+            for (char c : values[i]) {
+                if (c == '"' || c == '\\') array += '\\';
+                array += c;
+            }
+            array += '"';
+        }
+        array += '}';
+        return array;
+    }
+    
     std::chrono::system_clock::time_point parse_iso8601(const std::string& ts_str) {
         std::tm tm = {};
         std::istringstream ss(ts_str);
@@ -253,10 +396,19 @@ private:
     int backoff_ms_;
     int retry_count_;
     
+    // Serializes use of conn_
+    std::mutex db_mutex_;
+    
     // Caches
     std::mutex cache_mutex_;
     std::unordered_map<std::string, PortfolioSnapshot> portfolio_cache_;
-    std::unordered_map<std::string, TokenMetadata> token_cache_;
+    
+    std::mutex metadata_mutex_;
+    std::unordered_map<std::string, MetadataEntry> metadata_cache_;
+    std::vector<std::string> refresh_queue_;
+    std::condition_variable refresh_cv_;
+    std::atomic<bool> running_{true};
+    std::thread refresh_thread_;
 };
 
 // PostgresStore implementation using the Impl class
@@ -288,8 +440,8 @@ std::optional<TokenMetadata> PostgresStore::get_token_metadata(const std::string
     return impl_->get_token_metadata(mint);
 }
 
-std::vector<std::string> PostgresStore::get_token_list_mints() {
-    return impl_->get_token_list_mints();
+void PostgresStore::prefetch_token_metadata(const std::vector<std::string>& mints) {
+    impl_->prefetch_token_metadata(mints);
 }
 
 void PostgresStore::clear_caches() {
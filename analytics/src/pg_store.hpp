@@ -25,11 +25,13 @@ public:
     // Portfolio data
     std::optional<PortfolioSnapshot> get_portfolio(const std::string& wallet_address);
     
-    // Token metadata
+    // Token metadata, cached by fetch time. An expired entry is still served
+    // for metadata_stale_seconds while a background refresh re-reads it, and
+    // mints missing from tokens are cached as absent for a shorter TTL.
     std::optional<TokenMetadata> get_token_metadata(const std::string& mint);
     
-    // Market data
-    std::vector<std::string> get_token_list_mints();
+    // Loads the uncached or expired mints among these with a single query
+    void prefetch_token_metadata(const std::vector<std::string>& mints);
     
     // Cache management
     void clear_caches();
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+struct CurvePoint {
+    double x;
+    double y;
+};
+
+// Piecewise-linear curve through N breakpoints with non-decreasing x.
+//
+// Inputs are clamped to [first x, last x], so the curve is flat outside its
+// breakpoints. Two points with the same x make a step: the curve takes the
+// second point's y from that x on. Evaluation selects the segment with
+// conditional moves rather than a search and then does one multiply-add,
+// so it has no branches and vectorizes in batch loops.
+//
+// Curves made only of fixed breakpoints can be constexpr; curves that
+// depend on Config are built once at startup.
+template <std::size_t N>
+class PiecewiseLinear {
+    static_assert(N >= 2, "a curve needs at least two breakpoints");
+
+public:
+    constexpr explicit PiecewiseLinear(const CurvePoint (&points)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (i > 0 && points[i].x < points[i - 1].x) {
+                throw std::invalid_argument("curve breakpoints must have non-decreasing x");
+            }
+            x_[i] = points[i].x;
+            y_[i] = points[i].y;
+        }
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            double width = x_[i + 1] - x_[i];
+            slope_[i] = width > 0.0 ? (y_[i + 1] - y_[i]) / width : 0.0;
+        }
+    }
+    
+    constexpr double operator()(double x) const {
+        double clamped = std::min(std::max(x, x_[0]), x_[N - 1]);
+        
+        double x0 = x_[0];
+        double y0 = y_[0];
+        double slope = slope_[0];
+        for (std::size_t i = 1; i + 1 < N; ++i) {
+            bool past = clamped >= x_[i];
+            x0 = past ? x_[i] : x0;
+            y0 = past ? y_[i] : y0;
+            slope = past ? slope_[i] : slope;
+        }
+        
+        // The last breakpoint is hit exactly instead of through the lerp
+        double y = y0 + slope * (clamped - x0);
+        return clamped >= x_[N - 1] ? y_[N - 1] : y;
+    }
+
+private:
+    double x_[N]{};
+    double y_[N]{};
+    double slope_[N - 1]{};
+};
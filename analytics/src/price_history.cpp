@@ -0,0 +1,326 @@
+#include "price_history.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kBarSeconds = 300;
+constexpr int64_t kHourSeconds = 3600;
+constexpr int64_t kDaySeconds = 86400;
+
+// Closed bars needed before a window's indicators replace the single-bar ones
+constexpr size_t kMinBars1h = 3;
+constexpr size_t kMinBars24h = 12;
+
+// Enough closed bars for the longest window
+constexpr size_t kRingBars = kDaySeconds / kBarSeconds;
+
+constexpr size_t kShards = 16;
+
+struct Bar {
+    int64_t start = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double true_range = 0.0;
+    double log_return = 0.0;
+};
+
+// One trailing window over the ring. Bars tail..pushed-1 are inside it;
+// the deques hold bar sequence numbers with decreasing highs and
+// increasing lows, so their fronts are the window's high and low.
+struct Window {
+    Window(int64_t span, size_t min_bars) : span(span), min_bars(min_bars) {}
+    
+    int64_t span;
+    size_t min_bars;
+    uint64_t tail = 0;
+    std::deque<uint64_t> highs;
+    std::deque<uint64_t> lows;
+    double sum_true_range = 0.0;
+    double sum_squared_returns = 0.0;
+    bool has_reference = false;
+    double reference_close = 0.0;
+};
+
+class MintHistory {
+public:
+    MintHistory() : ring_(kRingBars), windows_{{Window(kHourSeconds, kMinBars1h), Window(kDaySeconds, kMinBars24h)}} {}
+    
+    void add_price(int64_t timestamp, double price) {
+        int64_t start = timestamp - timestamp % kBarSeconds;
+        
+        if (!has_current_) {
+            current_ = Bar{start, price, price, price, price};
+            has_current_ = true;
+            return;
+        }
+        
+        if (start > current_.start) {
+            close_bar();
+            current_ = Bar{start, price, price, price, price};
+            evict(start);
+            return;
+        }
+        
+        // Prices from before the bar in progress (a warm start's restored
+        // pools, say) would only distort its range
+        if (start < current_.start) {
+            return;
+        }
+        
+        current_.high = std::max(current_.high, price);
+        current_.low = std::min(current_.low, price);
+        current_.close = price;
+    }
+    
+    PriceIndicators indicators() const {
+        PriceIndicators result;
+        result.h1 = stats(windows_[0]);
+        result.h24 = stats(windows_[1]);
+        return result;
+    }
+    
+    std::chrono::steady_clock::time_point last_seen;
+
+private:
+    const Bar& at(uint64_t seq) const {
+        return ring_[seq % kRingBars];
+    }
+    
+    void close_bar() {
+        uint64_t seq = pushed_;
+        Bar bar = current_;
+        
+        double prev_close = seq > 0 ? at(seq - 1).close : bar.open;
+        bar.true_range = std::max({bar.high - bar.low,
+                                   std::abs(bar.high - prev_close),
+                                   std::abs(bar.low - prev_close)});
+        bar.log_return = prev_close > 0.0 && bar.close > 0.0 ? std::log(bar.close / prev_close) : 0.0;
+        
+        // The slot being reused must have left every window first
+        for (auto& window : windows_) {
+            while (window.tail < seq && seq - window.tail >= kRingBars) {
+                pop_tail(window);
+            }
+        }
+        
+        ring_[seq % kRingBars] = bar;
+        pushed_ = seq + 1;
+        
+        for (auto& window : windows_) {
+            while (!window.highs.empty() && at(window.highs.back()).high <= bar.high) {
+                window.highs.pop_back();
+            }
+            window.highs.push_back(seq);
+            
+            while (!window.lows.empty() && at(window.lows.back()).low >= bar.low) {
+                window.lows.pop_back();
+            }
+            window.lows.push_back(seq);
+            
+            window.sum_true_range += bar.true_range;
+            window.sum_squared_returns += bar.log_return * bar.log_return;
+        }
+        
+        if (pushed_ % kRingBars == 0) {
+            resum();
+        }
+    }
+    
+    // Drops bars that no longer overlap the window ending with the bar at start
+    void evict(int64_t start) {
+        for (auto& window : windows_) {
+            while (window.tail < pushed_ && at(window.tail).start <= start - window.span) {
+                pop_tail(window);
+            }
+        }
+    }
+    
+    void pop_tail(Window& window) {
+        const Bar& bar = at(window.tail);
+        window.sum_true_range -= bar.true_range;
+        window.sum_squared_returns -= bar.log_return * bar.log_return;
+        window.has_reference = true;
+        window.reference_close = bar.close;
+        
+        ++window.tail;
+        while (!window.highs.empty() && window.highs.front() < window.tail) {
+            window.highs.pop_front();
+        }
+        while (!window.lows.empty() && window.lows.front() < window.tail) {
+            window.lows.pop_front();
+        }
+    }
+    
+    // Exact sums from the ring, amortized over a full ring of pushes
+    void resum() {
+        for (auto& window : windows_) {
+            window.sum_true_range = 0.0;
+            window.sum_squared_returns = 0.0;
+            for (uint64_t seq = window.tail; seq < pushed_; ++seq) {
+                const Bar& bar = at(seq);
+                window.sum_true_range += bar.true_range;
+                window.sum_squared_returns += bar.log_return * bar.log_return;
+            }
+        }
+    }
+    
+    WindowStats stats(const Window& window) const {
+        WindowStats stats;
+        if (!has_current_) {
+            return stats;
+        }
+        
+        size_t bars = static_cast<size_t>(pushed_ - window.tail);
+        double price = current_.close;
+        
+        double reference = current_.open;
+        if (window.has_reference) {
+            reference = window.reference_close;
+        } else if (bars > 0) {
+            reference = at(window.tail).open;
+        }
+        
+        stats.bars = bars;
+        stats.ready = bars >= window.min_bars;
+        stats.return_pct = reference > 0.0 ? ((price / reference) - 1.0) * 100.0 : 0.0;
+        stats.high = current_.high;
+        stats.low = current_.low;
+        if (bars > 0) {
+            stats.high = std::max(stats.high, at(window.highs.front()).high);
+            stats.low = std::min(stats.low, at(window.lows.front()).low);
+            stats.atr_pct = price > 0.0 ? (window.sum_true_range / bars) / price * 100.0 : 0.0;
+        }
+        stats.range_pct = stats.low > 0.0 ? ((stats.high - stats.low) / stats.low) * 100.0 : 0.0;
+        stats.realized_vol_pct = std::sqrt(std::max(0.0, window.sum_squared_returns)) * 100.0;
+        return stats;
+    }
+    
+    std::vector<Bar> ring_;
+    uint64_t pushed_ = 0;
+    Bar current_;
+    bool has_current_ = false;
+    std::array<Window, 2> windows_;
+};
+
+} // namespace
+
+class PriceHistory::Impl {
+public:
+    explicit Impl(const Config& config) : config_(config) {}
+    
+    void update(const MarketUpdate& update) {
+        double price = update.price;
+        auto& shard = shard_for(update.mint_base);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& history = shard.mints[update.mint_base];
+        history.last_seen = std::chrono::steady_clock::now();
+        
+        if (price > 0.0 && std::isfinite(price)) {
+            auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                update.timestamp.time_since_epoch()).count();
+            history.add_price(timestamp, price);
+        }
+    }
+    
+    PriceIndicators indicators(const std::string& mint) const {
+        PriceIndicators result = own_indicators(mint);
+        add_relative(mint, result);
+        return result;
+    }
+    
+    size_t prune(std::chrono::steady_clock::duration max_idle) {
+        auto cutoff = std::chrono::steady_clock::now() - max_idle;
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.mints.begin(); it != shard.mints.end();) {
+                if (it->second.last_seen < cutoff) {
+                    it = shard.mints.erase(it);
+                    ++removed;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return removed;
+    }
+    
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.mints.size();
+        }
+        return total;
+    }
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, MintHistory> mints;
+    };
+    
+    Shard& shard_for(const std::string& mint) {
+        return shards_[std::hash<std::string>{}(mint) % kShards];
+    }
+    
+    const Shard& shard_for(const std::string& mint) const {
+        return shards_[std::hash<std::string>{}(mint) % kShards];
+    }
+    
+    PriceIndicators own_indicators(const std::string& mint) const {
+        const auto& shard = shard_for(mint);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.mints.find(mint);
+        if (it == shard.mints.end()) {
+            return PriceIndicators{};
+        }
+        return it->second.indicators();
+    }
+    
+    void add_relative(const std::string& mint, PriceIndicators& result) const {
+        if (!result.h1.ready) {
+            return;
+        }
+        
+        WindowStats sol = mint == config_.sol_mint ? result.h1 : own_indicators(config_.sol_mint).h1;
+        if (sol.ready) {
+            result.has_relative = true;
+            result.relative_1h_pct = result.h1.return_pct - sol.return_pct;
+        }
+    }
+    
+    const Config& config_;
+    std::array<Shard, kShards> shards_;
+};
+
+PriceHistory::PriceHistory(const Config& config) : impl_(std::make_unique<Impl>(config)) {}
+
+PriceHistory::~PriceHistory() = default;
+
+void PriceHistory::update(const MarketUpdate& update) {
+    impl_->update(update);
+}
+
+PriceIndicators PriceHistory::indicators(const std::string& mint) const {
+    return impl_->indicators(mint);
+}
+
+size_t PriceHistory::prune(std::chrono::steady_clock::duration max_idle) {
+    return impl_->prune(max_idle);
+}
+
+size_t PriceHistory::size() const {
+    return impl_->size();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "config.hpp"
+#include "types.hpp"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Indicators over one trailing window of a mint's price history
+struct WindowStats {
+    bool ready = false;             // enough closed bars to trust the window
+    size_t bars = 0;                // closed bars in the window
+    double return_pct = 0.0;        // latest price against the close before the window
+    double high = 0.0;              // including the bar in progress
+    double low = 0.0;
+    double range_pct = 0.0;         // (high - low) / low
+    double atr_pct = 0.0;           // mean true range of the closed bars, % of price
+    double realized_vol_pct = 0.0;  // sqrt of the summed squared bar log returns
+};
+
+struct PriceIndicators {
+    WindowStats h1;
+    WindowStats h24;
+    bool has_relative = false;
+    double relative_1h_pct = 0.0;   // 1h return minus SOL's 1h return
+};
+
+// Rolling per-mint price history built from the market update stream.
+//
+// Every mint keeps a ring of closed 5-minute bars covering 24 hours plus the
+// bar in progress. The 1h and 24h windows each keep monotonic deques for
+// their high and low and running sums for true range and squared log
+// returns, so an update costs O(1) amortized whatever the window length.
+// The sums are rebuilt from the ring once per ring cycle so subtraction
+// error cannot accumulate.
+//
+// Updates for one mint must arrive in order from one thread at a time; the
+// service feeds every update from the market stream subscriber, before the
+// scoring pool coalesces them. Indicators may be read from any thread.
+class PriceHistory {
+public:
+    explicit PriceHistory(const Config& config);
+    ~PriceHistory();
+    
+    // Record the update's price
+    void update(const MarketUpdate& update);
+    
+    // Indicators as of the mint's last update
+    PriceIndicators indicators(const std::string& mint) const;
+    
+    // Forget mints without an update for max_idle; returns how many
+    size_t prune(std::chrono::steady_clock::duration max_idle);
+    
+    size_t size() const;
+    
+    // Non-copyable
+    PriceHistory(const PriceHistory&) = delete;
+    PriceHistory& operator=(const PriceHistory&) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
@@ -2,11 +2,46 @@
 #include "redis_bus.hpp"
 #include <spdlog/spdlog.h>
 #include <chrono>
+#include <iterator>
 #include <thread>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
+namespace {
+
+using StreamAttrs = std::unordered_map<std::string, std::string>;
+using StreamItem = std::pair<std::string, StreamAttrs>;
+using StreamBatch = std::vector<StreamItem>;
+
+// One XREADGROUP for up to `count` new entries. A full batch means the
+// consumer is behind, so the next read skips BLOCK and drains the backlog;
+// otherwise it blocks for up to `block` waiting for new entries.
+StreamBatch read_batch(sw::redis::Redis& redis, const std::string& group, const std::string& consumer,
+                       const std::string& stream, long long count, std::chrono::milliseconds block,
+                       bool backlog) {
+    std::unordered_map<std::string, StreamBatch> result;
+    if (backlog) {
+        redis.xreadgroup(group, consumer, stream, ">", count, std::inserter(result, result.end()));
+    } else {
+        redis.xreadgroup(group, consumer, stream, ">", block, count, std::inserter(result, result.end()));
+    }
+    
+    auto it = result.find(stream);
+    return it == result.end() ? StreamBatch{} : std::move(it->second);
+}
+
+// Single multi-ID XACK for a processed batch
+void ack_batch(sw::redis::Redis& redis, const std::string& stream, const std::string& group,
+               const std::vector<std::string>& ids) {
+    if (!ids.empty()) {
+        redis.xack(stream, group, ids.begin(), ids.end());
+    }
+}
+
+} // namespace
+
 class RedisBus::Impl {
 public:
     Impl(const Config& config) 
@@ -78,7 +113,7 @@ public:
         return false;
     }
 
-    void subscribe_market_updates(std::function<void(const MarketUpdate&)> callback) {
+    void subscribe_market_updates(std::function<void(const std::vector<MarketUpdate>&)> callback) {
         if (market_thread_.joinable()) {
             spdlog::warn("Market updates subscriber already running");
             return;
@@ -102,37 +137,47 @@ public:
             
             std::string consumer_id = "analytics_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
             
+            bool backlog = false;
+            std::vector<std::string> acked;
+            std::vector<MarketUpdate> updates;
+            
             while (running_) {
                 try {
-                    // Read from the stream with a block of 1000ms
-                    auto result = redis.xreadgroup("analytics_group", consumer_id, 
-                                                  {{config_.stream_market, ">"}}, 
-                                                  1, 1000);
+                    auto entries = read_batch(redis, "analytics_group", consumer_id, config_.stream_market,
+                                              config_.stream_batch_size,
+                                              std::chrono::milliseconds(config_.stream_block_ms), backlog);
+                    backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
                     
-                    if (!result.empty() && !result[0].second.empty()) {
-                        const auto& stream_entries = result[0].second;
-                        for (const auto& entry : stream_entries) {
-                            const auto& id = entry.first;
-                            const auto& fields = entry.second;
-                            
-                            try {
-                                if (fields.find("data") != fields.end()) {
-                                    auto j = json::parse(fields.at("data"));
-                                    auto update = MarketUpdate::from_json(j);
-                                    if (update) {
-                                        callback(*update);
-                                    }
+                    acked.clear();
+                    updates.clear();
+                    for (const auto& entry : entries) {
+                        const auto& id = entry.first;
+                        const auto& fields = entry.second;
+                        
+                        try {
+                            if (fields.find("data") != fields.end()) {
+                                auto j = json::parse(fields.at("data"));
+                                auto update = MarketUpdate::from_json(j);
+                                if (update) {
+                                    updates.push_back(std::move(*update));
                                 }
-                                
-                                // Acknowledge the message
-                                redis.xack(config_.stream_market, "analytics_group", id);
-                            } catch (const std::exception& e) {
-                                spdlog::error("Error processing market update: {}", e.what());
                             }
+                            
+                            acked.push_back(id);
+                        } catch (const std::exception& e) {
+                            spdlog::error("Error processing market update: {}", e.what());
                         }
                     }
+                    
+                    if (!updates.empty()) {
+                        callback(updates);
+                    }
+                    
+                    // Acknowledge the whole batch in one round trip
+                    ack_batch(redis, config_.stream_market, "analytics_group", acked);
                 } catch (const std::exception& e) {
                     spdlog::error("Error in market updates subscriber: {}", e.what());
+                    backlog = false;
                     std::this_thread::sleep_for(std::chrono::seconds(1));
                 }
             }
@@ -165,37 +210,41 @@ public:
             
             std::string consumer_id = "analytics_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
             
+            bool backlog = false;
+            std::vector<std::string> acked;
+            
             while (running_) {
                 try {
-                    // Read from the stream with a block of 1000ms
-                    auto result = redis.xreadgroup("analytics_group", consumer_id, 
-                                                  {{config_.stream_req, ">"}}, 
-                                                  1, 1000);
+                    auto entries = read_batch(redis, "analytics_group", consumer_id, config_.stream_req,
+                                              config_.stream_batch_size,
+                                              std::chrono::milliseconds(config_.stream_block_ms), backlog);
+                    backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
                     
-                    if (!result.empty() && !result[0].second.empty()) {
-                        const auto& stream_entries = result[0].second;
-                        for (const auto& entry : stream_entries) {
-                            const auto& id = entry.first;
-                            const auto& fields = entry.second;
-                            
-                            try {
-                                if (fields.find("data") != fields.end()) {
-                                    auto j = json::parse(fields.at("data"));
-                                    auto request = CommandRequest::from_json(j);
-                                    if (request && request->cmd == "signals") {
-                                        callback(*request);
-                                    }
+                    acked.clear();
+                    for (const auto& entry : entries) {
+                        const auto& id = entry.first;
+                        const auto& fields = entry.second;
+                        
+                        try {
+                            if (fields.find("data") != fields.end()) {
+                                auto j = json::parse(fields.at("data"));
+                                auto request = CommandRequest::from_json(j);
+                                if (request && request->cmd == "signals") {
+                                    callback(*request);
                                 }
-                                
-                                // Acknowledge the message
-                                redis.xack(config_.stream_req, "analytics_group", id);
-                            } catch (const std::exception& e) {
-                                spdlog::error("Error processing command request: {}", e.what());
                             }
+                            
+                            acked.push_back(id);
+                        } catch (const std::exception& e) {
+                            spdlog::error("Error processing command request: {}", e.what());
                         }
                     }
+                    
+                    // Acknowledge the whole batch in one round trip
+                    ack_batch(redis, config_.stream_req, "analytics_group", acked);
                 } catch (const std::exception& e) {
                     spdlog::error("Error in command requests subscriber: {}", e.what());
+                    backlog = false;
                     std::this_thread::sleep_for(std::chrono::seconds(1));
                 }
             }
@@ -263,6 +312,24 @@ public:
         }
     }
 
+    bool mark_watched(const std::string& mint, std::chrono::seconds ttl) {
+        if (!ensure_connection()) {
+            return false;
+        }
+
+        try {
+            // Scored by expiry so the ingestor can range-query live marks
+            auto expiry = std::chrono::system_clock::now() + ttl;
+            double expiry_ms = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                expiry.time_since_epoch()).count());
+            redis_->zadd(config_.watchlist_key, mint, expiry_ms);
+            return true;
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to mark {} as watched: {}", mint, e.what());
+            return false;
+        }
+    }
+
 private:
     const Config& config_;
     std::unique_ptr<sw::redis::Redis> redis_;
@@ -297,7 +364,7 @@ bool RedisBus::ensure_connection() {
     return impl_->ensure_connection();
 }
 
-void RedisBus::subscribe_market_updates(std::function<void(const MarketUpdate&)> callback) {
+void RedisBus::subscribe_market_updates(std::function<void(const std::vector<MarketUpdate>&)> callback) {
     impl_->subscribe_market_updates(std::move(callback));
 }
 
@@ -316,3 +383,7 @@ bool RedisBus::publish_alert(const AlertData& alert) {
 bool RedisBus::publish_command_reply(const CommandReply& reply) {
     return impl_->publish_command_reply(reply);
 }
+
+bool RedisBus::mark_watched(const std::string& mint, std::chrono::seconds ttl) {
+    return impl_->mark_watched(mint, ttl);
+}
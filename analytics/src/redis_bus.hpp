@@ -10,7 +10,9 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
 #include <queue>
+#include <vector>
 
 class RedisBus {
 public:
@@ -24,13 +26,17 @@ public:
     bool ensure_connection();
 
     // Subscription methods
-    void subscribe_market_updates(std::function<void(const MarketUpdate&)> callback);
+    // The callback receives each stream batch at once, in stream order
+    void subscribe_market_updates(std::function<void(const std::vector<MarketUpdate>&)> callback);
     void subscribe_command_requests(std::function<void(const CommandRequest&)> callback);
     void stop_subscribers();
 
     // Publishing methods
     bool publish_alert(const AlertData& alert);
     bool publish_command_reply(const CommandReply& reply);
+    
+    // Ask the ingestor to refresh this mint's pools at high priority until ttl elapses
+    bool mark_watched(const std::string& mint, std::chrono::seconds ttl);
 
     // Non-copyable
     RedisBus(const RedisBus&) = delete;
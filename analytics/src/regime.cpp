@@ -1,91 +1,136 @@
-
 #include "regime.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
-#include <numeric>
+#include <cmath>
+
+namespace {
+
+// One-minute buckets covering 24 hours
+constexpr size_t kBuckets = 24 * 60;
+
+// Data points needed before the regime can turn risk-on
+constexpr int64_t kMinDataPoints = 3;
 
-RegimeDetector::RegimeDetector(const Config& config) 
-    : config_(config), risk_on_(false) {}
+int64_t epoch_minute(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::minutes>(tp.time_since_epoch()).count();
+}
+
+} // namespace
+
+RegimeDetector::RegimeDetector(const Config& config)
+    : config_(config), buckets_(kBuckets) {}
 
 bool RegimeDetector::is_risk_on() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return risk_on_;
+    return risk_on_.load(std::memory_order_relaxed);
 }
 
 void RegimeDetector::update_regime(double sol_price, double sol_24h_change_pct) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto now = std::chrono::system_clock::now();
+    // A clock step backwards lands in the newest bucket
+    advance(epoch_minute(std::chrono::system_clock::now()));
+    auto& bucket = buckets_[static_cast<size_t>(head_minute_) % kBuckets];
     
     // Add new data point
-    RegimeDataPoint point;
-    point.sol_price = sol_price;
-    point.sol_24h_change_pct = sol_24h_change_pct;
-    point.timestamp = now;
+    ++bucket.count;
+    bucket.sum_change += sol_24h_change_pct;
+    bucket.sum_price += sol_price;
+    ++count_;
+    sum_change_ += sol_24h_change_pct;
+    sum_price_ += sol_price;
     
-    data_points_.push_back(point);
+    // The bucket's return runs from the previous close to its latest price
+    double squared_return = 0.0;
+    if (sol_price > 0.0 && previous_close_ > 0.0) {
+        double log_return = std::log(sol_price / previous_close_);
+        squared_return = log_return * log_return;
+    }
+    sum_squared_returns_ += squared_return - bucket.squared_return;
+    bucket.squared_return = squared_return;
+    bucket.close = sol_price;
     
-    // Remove old data points
-    data_points_.erase(
-        std::remove_if(
-            data_points_.begin(),
-            data_points_.end(),
-            [now](const RegimeDataPoint& point) {
-                auto elapsed = std::chrono::duration_cast<std::chrono::hours>(now - point.timestamp).count();
-                return elapsed > 24; // Keep 24 hours of data
-            }
-        ),
-        data_points_.end()
-    );
+    double realized_vol = std::sqrt(std::max(0.0, sum_squared_returns_)) * 100.0;
+    realized_vol_pct_.store(realized_vol, std::memory_order_relaxed);
     
     // Need at least a few data points to determine regime
-    if (data_points_.size() < 3) {
-        risk_on_ = false;
+    if (count_ < kMinDataPoints) {
+        risk_on_.store(false, std::memory_order_relaxed);
         return;
     }
     
     // Calculate average SOL price change
-    double avg_change = std::accumulate(
-        data_points_.begin(),
-        data_points_.end(),
-        0.0,
-        [](double sum, const RegimeDataPoint& point) {
-            return sum + point.sol_24h_change_pct;
-        }
-    ) / data_points_.size();
+    double avg_change = sum_change_ / static_cast<double>(count_);
     
     // Calculate price momentum (last price vs average of previous prices)
-    double current_price = data_points_.back().sol_price;
-    double avg_price = 0.0;
-    if (data_points_.size() > 1) {
-        avg_price = std::accumulate(
-            data_points_.begin(),
-            data_points_.end() - 1,
-            0.0,
-            [](double sum, const RegimeDataPoint& point) {
-                return sum + point.sol_price;
-            }
-        ) / (data_points_.size() - 1);
-    } else {
-        avg_price = current_price;
-    }
-    
-    double price_momentum = ((current_price / avg_price) - 1.0) * 100.0;
+    double avg_price = (sum_price_ - sol_price) / static_cast<double>(count_ - 1);
+    double price_momentum = ((sol_price / avg_price) - 1.0) * 100.0;
     
-    // Determine regime
-    bool new_risk_on = (avg_change > config_.risk_on_sol_change_threshold) && 
-                      (price_momentum > config_.risk_on_momentum_threshold);
+    // Determine regime; the volatility term only applies when configured
+    bool calm = config_.regime_max_sol_vol_pct <= 0.0 || realized_vol <= config_.regime_max_sol_vol_pct;
+    bool new_risk_on = (avg_change > config_.risk_on_sol_change_threshold) &&
+                      (price_momentum > config_.risk_on_momentum_threshold) &&
+                      calm;
     
     // Log regime change
-    if (new_risk_on != risk_on_) {
-        spdlog::info("Risk regime changed to {}: SOL avg change {:.2f}%, momentum {:.2f}%",
-                    new_risk_on ? "RISK-ON" : "RISK-OFF", avg_change, price_momentum);
+    bool old_risk_on = risk_on_.exchange(new_risk_on, std::memory_order_relaxed);
+    if (new_risk_on != old_risk_on) {
+        spdlog::info("Risk regime changed to {}: SOL avg change {:.2f}%, momentum {:.2f}%, realized vol {:.2f}%",
+                    new_risk_on ? "RISK-ON" : "RISK-OFF", avg_change, price_momentum, realized_vol);
     }
-    
-    risk_on_ = new_risk_on;
 }
 
 std::string RegimeDetector::get_regime_string() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return risk_on_ ? "RISK-ON" : "RISK-OFF";
+    return is_risk_on() ? "RISK-ON" : "RISK-OFF";
+}
+
+double RegimeDetector::sol_realized_vol_pct() const {
+    return realized_vol_pct_.load(std::memory_order_relaxed);
+}
+
+void RegimeDetector::advance(int64_t minute) {
+    if (minute <= head_minute_) {
+        return;
+    }
+    
+    // The head's close is the reference for the next bucket with data
+    if (head_minute_ >= 0) {
+        const auto& head = buckets_[static_cast<size_t>(head_minute_) % kBuckets];
+        if (head.count > 0) {
+            previous_close_ = head.close;
+        }
+    }
+    
+    // Reuse every slot between the old head and the new one; after a gap of
+    // a full day or more that is each slot once
+    bool rebuild = false;
+    for (int64_t m = std::max(head_minute_ + 1, minute - static_cast<int64_t>(kBuckets) + 1); m <= minute; ++m) {
+        auto& bucket = buckets_[static_cast<size_t>(m) % kBuckets];
+        count_ -= bucket.count;
+        sum_change_ -= bucket.sum_change;
+        sum_price_ -= bucket.sum_price;
+        sum_squared_returns_ -= bucket.squared_return;
+        bucket = Bucket{m};
+        if (++advanced_ % kBuckets == 0) {
+            rebuild = true;
+        }
+    }
+    head_minute_ = minute;
+    
+    if (rebuild) {
+        resum();
+    }
+}
+
+// Exact sums from the ring, amortized over a full ring of advances
+void RegimeDetector::resum() {
+    count_ = 0;
+    sum_change_ = 0.0;
+    sum_price_ = 0.0;
+    sum_squared_returns_ = 0.0;
+    for (const auto& bucket : buckets_) {
+        count_ += bucket.count;
+        sum_change_ += bucket.sum_change;
+        sum_price_ += bucket.sum_price;
+        sum_squared_returns_ += bucket.squared_return;
+    }
 }
@@ -1,10 +1,25 @@
 #pragma once
 
 #include "config.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <mutex>
+#include <string>
 #include <vector>
 
+// Market risk regime from SOL's price over the last 24 hours.
+//
+// SOL updates are folded into a ring of one-minute buckets with running
+// sums (24h change, price, squared log returns between bucket closes), so an
+// update is O(1) whatever its rate; the sums are rebuilt from the ring once
+// per cycle so subtraction error cannot build up. The regime is published
+// through atomics, so the per-update is_risk_on() check never takes a lock.
+//
+// Risk-on needs SOL's average 24h change and its momentum (latest price
+// against the average of the earlier ones) above their thresholds, and,
+// when regime_max_sol_vol_pct is set, SOL's 24h realized volatility at or
+// below it.
 class RegimeDetector {
 public:
     explicit RegimeDetector(const Config& config);
@@ -17,16 +32,38 @@ public:
     
     // Get the current regime as a string
     std::string get_regime_string() const;
+    
+    // SOL's realized volatility over the window, from one-minute closes
+    double sol_realized_vol_pct() const;
 
 private:
-    struct RegimeDataPoint {
-        double sol_price;
-        double sol_24h_change_pct;
-        std::chrono::system_clock::time_point timestamp;
+    struct Bucket {
+        int64_t minute = -1;
+        int64_t count = 0;
+        double sum_change = 0.0;
+        double sum_price = 0.0;
+        double close = 0.0;
+        double squared_return = 0.0;   // close against the previous bucket's close
     };
     
+    // Move the window's head to minute, dropping buckets that left it
+    void advance(int64_t minute);
+    
+    void resum();
+    
     const Config& config_;
-    mutable std::mutex mutex_;
-    std::vector<RegimeDataPoint> data_points_;
-    bool risk_on_;
+    std::mutex mutex_;   // serializes writers; readers use the atomics
+    
+    std::vector<Bucket> buckets_;
+    int64_t head_minute_ = -1;
+    uint64_t advanced_ = 0;
+    double previous_close_ = 0.0;   // close of the bucket before the head
+    
+    int64_t count_ = 0;
+    double sum_change_ = 0.0;
+    double sum_price_ = 0.0;
+    double sum_squared_returns_ = 0.0;
+    
+    std::atomic<bool> risk_on_{false};
+    std::atomic<double> realized_vol_pct_{0.0};
 };
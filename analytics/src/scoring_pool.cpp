@@ -0,0 +1,347 @@
+#include "scoring_pool.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// Updates a worker scores from one lane before handing the mint back to its
+// queue, so a mint that keeps receiving updates cannot starve the others
+constexpr size_t kLaneTurn = 16;
+
+// Idle workers re-check for stealable lanes at least this often
+constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
+double to_ms(std::chrono::steady_clock::duration elapsed) {
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+struct LatencyAccumulator {
+    std::string stage;
+    uint64_t count = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+} // namespace
+
+class ScoringPool::Impl {
+public:
+    Impl(size_t workers, size_t max_pending_mints, Handler handler)
+        : handler_(std::move(handler)),
+          workers_(std::max<size_t>(1, workers)),
+          max_pending_mints_(std::max<size_t>(1, max_pending_mints)) {}
+    
+    ~Impl() {
+        stop();
+    }
+    
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        
+        started_ = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i].thread = std::thread(&Impl::worker_loop, this, i);
+        }
+        spdlog::info("Scoring pool started with {} workers", workers_.size());
+    }
+    
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_cv_.notify_all();
+        
+        for (auto& worker : workers_) {
+            if (worker.thread.joinable()) {
+                worker.thread.join();
+            }
+        }
+        spdlog::info("Scoring pool stopped, {} updates left unscored", queue_depth_.load());
+    }
+    
+    void submit(MarketUpdate update) {
+        std::string mint = update.mint_base;
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex_);
+            auto it = lanes_.find(mint);
+            if (it == lanes_.end()) {
+                if (lanes_.size() >= max_pending_mints_) {
+                    if (dropped_++ % 10000 == 0) {
+                        spdlog::warn("Scoring pool at {} pending mints, dropping updates", lanes_.size());
+                    }
+                    return;
+                }
+                it = lanes_.emplace(mint, Lane{}).first;
+            }
+            
+            // Latest wins; the wait is still measured from the oldest replaced update
+            auto& lane = it->second;
+            if (lane.pending) {
+                lane.pending->update = std::move(update);
+                ++coalesced_;
+            } else {
+                lane.pending = Queued{std::move(update), std::chrono::steady_clock::now()};
+                ++queue_depth_;
+            }
+            if (!lane.scheduled) {
+                lane.scheduled = true;
+                schedule = true;
+            }
+        }
+        
+        if (schedule) {
+            enqueue(std::hash<std::string>{}(mint) % workers_.size(), std::move(mint));
+        }
+    }
+    
+    void record_stage(const std::string& stage, std::chrono::steady_clock::duration elapsed) {
+        double ms = to_ms(elapsed);
+        
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        auto it = std::find_if(stages_.begin(), stages_.end(),
+            [&stage](const LatencyAccumulator& acc) { return acc.stage == stage; });
+        if (it == stages_.end()) {
+            stages_.push_back(LatencyAccumulator{stage});
+            it = stages_.end() - 1;
+        }
+        ++it->count;
+        it->total_ms += ms;
+        it->max_ms = std::max(it->max_ms, ms);
+    }
+    
+    ScoringPoolStats stats(const ScoringPoolStats* since) const {
+        ScoringPoolStats stats;
+        stats.queue_depth = queue_depth_.load();
+        stats.processed = processed_.load();
+        stats.coalesced = coalesced_.load();
+        stats.dropped = dropped_.load();
+        stats.stolen = stolen_.load();
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex_);
+            stats.active_mints = lanes_.size();
+        }
+        
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats.taken = std::chrono::steady_clock::now();
+        auto interval_start = since ? since->taken : started_;
+        double interval_ns = std::chrono::duration<double, std::nano>(stats.taken - interval_start).count();
+        
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            int64_t busy = workers_[i].busy_ns.load();
+            stats.worker_busy_ns.push_back(busy);
+            if (since && i < since->worker_busy_ns.size()) {
+                busy -= since->worker_busy_ns[i];
+            }
+            double busy_ns = static_cast<double>(busy);
+            stats.worker_utilization.push_back(interval_ns > 0.0 ? std::min(1.0, busy_ns / interval_ns) : 0.0);
+        }
+        
+        for (const auto& acc : stages_) {
+            StageLatency latency;
+            latency.stage = acc.stage;
+            latency.total_count = acc.count;
+            latency.total_ms = acc.total_ms;
+            latency.max_ms = acc.max_ms;
+            
+            latency.count = acc.count;
+            double total_ms = acc.total_ms;
+            if (since) {
+                auto prev = std::find_if(since->stages.begin(), since->stages.end(),
+                    [&acc](const StageLatency& s) { return s.stage == acc.stage; });
+                if (prev != since->stages.end()) {
+                    latency.count -= prev->total_count;
+                    total_ms -= prev->total_ms;
+                }
+            }
+            latency.avg_ms = latency.count > 0 ? total_ms / static_cast<double>(latency.count) : 0.0;
+            stats.stages.push_back(std::move(latency));
+        }
+        
+        return stats;
+    }
+
+private:
+    struct Queued {
+        MarketUpdate update;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+    
+    // Newest unscored update of one mint; `scheduled` is set while the mint
+    // sits in a ready queue or a worker is draining it, which is what keeps
+    // it single-threaded
+    struct Lane {
+        std::optional<Queued> pending;
+        bool scheduled = false;
+    };
+    
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::string> ready;
+        std::thread thread;
+        std::atomic<int64_t> busy_ns{0};
+    };
+    
+    void enqueue(size_t worker, std::string mint) {
+        {
+            std::lock_guard<std::mutex> lock(workers_[worker].mutex);
+            workers_[worker].ready.push_back(std::move(mint));
+            ++ready_count_;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_cv_.notify_one();
+    }
+    
+    // Own queue from the front, then other queues from the back
+    bool next_mint(size_t self, std::string& mint, bool& stolen) {
+        for (size_t k = 0; k < workers_.size(); ++k) {
+            auto& worker = workers_[(self + k) % workers_.size()];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (worker.ready.empty()) continue;
+            
+            if (k == 0) {
+                mint = std::move(worker.ready.front());
+                worker.ready.pop_front();
+            } else {
+                mint = std::move(worker.ready.back());
+                worker.ready.pop_back();
+            }
+            --ready_count_;
+            stolen = k != 0;
+            return true;
+        }
+        return false;
+    }
+    
+    void worker_loop(size_t self) {
+        while (running_) {
+            std::string mint;
+            bool stolen = false;
+            if (!next_mint(self, mint, stolen)) {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_cv_.wait_for(lock, kIdleWait, [this] {
+                    return !running_ || ready_count_ > 0;
+                });
+                continue;
+            }
+            
+            if (stolen) {
+                ++stolen_;
+            }
+            run_lane(self, mint);
+        }
+    }
+    
+    void run_lane(size_t self, const std::string& mint) {
+        for (size_t turn = 0; turn < kLaneTurn && running_; ++turn) {
+            Queued queued;
+            {
+                std::lock_guard<std::mutex> lock(lanes_mutex_);
+                auto it = lanes_.find(mint);
+                if (it == lanes_.end()) {
+                    return;
+                }
+                if (!it->second.pending) {
+                    lanes_.erase(it);
+                    return;
+                }
+                queued = std::move(*it->second.pending);
+                it->second.pending.reset();
+                --queue_depth_;
+            }
+            
+            auto started = std::chrono::steady_clock::now();
+            record_stage("queue_wait", started - queued.enqueued);
+            try {
+                handler_(queued.update);
+            } catch (const std::exception& e) {
+                spdlog::error("Scoring worker {} failed on {}: {}", self, mint, e.what());
+            }
+            auto elapsed = std::chrono::steady_clock::now() - started;
+            record_stage("total", elapsed);
+            workers_[self].busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            ++processed_;
+        }
+        
+        // Turn used up: the mint goes to the back of this worker's queue
+        {
+            std::lock_guard<std::mutex> lock(lanes_mutex_);
+            auto it = lanes_.find(mint);
+            if (it == lanes_.end()) {
+                return;
+            }
+            if (!it->second.pending) {
+                lanes_.erase(it);
+                return;
+            }
+        }
+        enqueue(self, mint);
+    }
+    
+    Handler handler_;
+    std::vector<Worker> workers_;
+    std::atomic<bool> running_{false};
+    
+    mutable std::mutex lanes_mutex_;
+    std::unordered_map<std::string, Lane> lanes_;
+    size_t max_pending_mints_;
+    
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<size_t> ready_count_{0};
+    
+    std::atomic<size_t> queue_depth_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> stolen_{0};
+    
+    mutable std::mutex stats_mutex_;
+    std::vector<LatencyAccumulator> stages_;
+    std::chrono::steady_clock::time_point started_;
+};
+
+ScoringPool::ScoringPool(size_t workers, size_t max_pending_mints, Handler handler)
+    : impl_(std::make_unique<Impl>(workers, max_pending_mints, std::move(handler))) {}
+
+ScoringPool::~ScoringPool() = default;
+
+void ScoringPool::start() {
+    impl_->start();
+}
+
+void ScoringPool::stop() {
+    impl_->stop();
+}
+
+void ScoringPool::submit(MarketUpdate update) {
+    impl_->submit(std::move(update));
+}
+
+void ScoringPool::record_stage(const std::string& stage, std::chrono::steady_clock::duration elapsed) {
+    impl_->record_stage(stage, elapsed);
+}
+
+ScoringPoolStats ScoringPool::stats() const {
+    return impl_->stats(nullptr);
+}
+
+ScoringPoolStats ScoringPool::stats(const ScoringPoolStats& since) const {
+    return impl_->stats(&since);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "types.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Latency of one processing stage over the reading's interval
+struct StageLatency {
+    std::string stage;
+    uint64_t count = 0;
+    double avg_ms = 0.0;
+    double max_ms = 0.0;        // largest since start; a maximum has no delta
+    
+    // Cumulative totals the next interval is measured from
+    uint64_t total_count = 0;
+    double total_ms = 0.0;
+};
+
+struct ScoringPoolStats {
+    size_t queue_depth = 0;                  // updates waiting to be scored, at most one per mint
+    size_t active_mints = 0;                 // mints with queued or in-flight updates
+    uint64_t processed = 0;                  // updates scored since start
+    uint64_t coalesced = 0;                  // pending updates replaced by a newer one since start
+    uint64_t dropped = 0;                    // updates refused at the pending-mint cap since start
+    uint64_t stolen = 0;                     // lane turns run off their home worker since start
+    std::vector<double> worker_utilization;  // busy fraction per worker over the interval
+    std::vector<StageLatency> stages;        // queue_wait, total and handler-recorded stages
+    
+    // Cumulative readings the next interval is measured from
+    std::chrono::steady_clock::time_point taken;
+    std::vector<int64_t> worker_busy_ns;
+};
+
+// Fixed set of worker threads scoring market updates.
+//
+// Updates are sharded by mint: every mint has a lane that at most one worker
+// drains at a time, so a mint's updates are scored in arrival order while
+// different mints are scored in parallel. A lane holds only the newest
+// pending update: one arriving before the previous was picked up replaces
+// it, so a backlog costs one scoring pass per mint rather than one per
+// update. A lane with a pending update is queued on its home worker (picked
+// by hashing the mint); a worker with an empty queue steals lanes from the
+// back of the other workers' queues.
+//
+// Memory is bounded by max_pending_mints lanes of one update each; updates
+// for further mints are dropped until lanes drain.
+class ScoringPool {
+public:
+    using Handler = std::function<void(const MarketUpdate&)>;
+    
+    ScoringPool(size_t workers, size_t max_pending_mints, Handler handler);
+    ~ScoringPool();
+    
+    void start();
+    
+    // Join the workers; updates still queued are dropped
+    void stop();
+    
+    void submit(MarketUpdate update);
+    
+    // Attribute part of the handler's time to a named stage
+    void record_stage(const std::string& stage, std::chrono::steady_clock::duration elapsed);
+    
+    // Counters plus the latency and utilization since start
+    ScoringPoolStats stats() const;
+    
+    // The same over the interval since `since`, an earlier reading of this
+    // pool. Readings reset nothing, so each consumer keeps its own previous
+    // one and none skews another's interval.
+    ScoringPoolStats stats(const ScoringPoolStats& since) const;
+    
+    // Non-copyable
+    ScoringPool(const ScoringPool&) = delete;
+    ScoringPool& operator=(const ScoringPool&) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
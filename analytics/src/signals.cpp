@@ -4,27 +4,300 @@
 #include <cmath>
 #include <fmt/format.h>
 
-SignalCalculator::SignalCalculator(const Config& config) : config_(config) {}
+namespace {
+
+// Curves with fixed breakpoints
+constexpr PiecewiseLinear<4> kVolatilityCurve({   // S5, by 15m high-low range %
+    {0.0, 0.0}, {5.0, 0.5}, {10.0, 0.8}, {20.0, 1.0}
+});
+constexpr PiecewiseLinear<2> kDiscoveryVolatilityCap({   // S6 caps S5 at 0.8
+    {0.0, 0.0}, {0.8, 0.8}
+});
+constexpr PiecewiseLinear<3> kRelativeStrengthCurve({   // S9, by 1h return minus SOL's
+    {-10.0, 0.0}, {0.0, 0.5}, {10.0, 1.0}
+});
+constexpr PiecewiseLinear<2> kAgeFactorCurve({   // S7, full credit at 30 days
+    {0.0, 0.0}, {720.0, 1.0}
+});
+constexpr PiecewiseLinear<2> kHolderFactorCurve({   // S7, by top holder %
+    {0.0, 1.0}, {100.0, 0.0}
+});
+
+static_assert(kVolatilityCurve(10.0) == 0.8 && kVolatilityCurve(-1.0) == 0.0 && kVolatilityCurve(50.0) == 1.0,
+              "volatility curve passes through its breakpoints and clamps outside them");
+    
+// Per-element signal kernels shared by the scalar and batch paths. The
+// curves themselves are branch-free, and the remaining conditions are
+// selects, so the batch loops vectorize. Bit-for-bit agreement between the
+// paths relies on both using these functions and on signals.cpp being built
+// without FMA contraction or -ffast-math (see CMakeLists.txt).
+
+// Momentum, range and relative-strength inputs: the rolling windows once
+// they hold enough bars, otherwise the single-bar approximations
+struct MomentumInputs {
+    bool has_m1h = false;
+    double m1h_pct = 0.0;
+    double m24h_pct = 0.0;
+    bool has_range = false;
+    double range_pct = 0.0;
+    bool has_relative = false;
+    double relative_pct = 0.0;
+};
+
+MomentumInputs momentum_inputs(const MarketUpdate& update, const PriceIndicators& indicators) {
+    MomentumInputs inputs;
+    auto it_5m = update.bars.find("5m");
+    auto it_15m = update.bars.find("15m");
+    
+    if (indicators.h1.ready) {
+        inputs.has_m1h = true;
+        inputs.m1h_pct = indicators.h1.return_pct;
+        inputs.has_range = true;
+        inputs.range_pct = indicators.h1.range_pct;
+    } else {
+        if (it_5m != update.bars.end()) {
+            inputs.has_m1h = true;
+            inputs.m1h_pct = ((it_5m->second.close / it_5m->second.open) - 1.0) * 100.0;
+        }
+        if (it_15m != update.bars.end()) {
+            inputs.has_range = true;
+            inputs.range_pct = ((it_15m->second.high - it_15m->second.low) / it_15m->second.low) * 100.0;
+        }
+    }
+    
+    if (indicators.h24.ready) {
+        inputs.m24h_pct = indicators.h24.return_pct;
+    } else if (it_15m != update.bars.end()) {
+        inputs.m24h_pct = ((it_15m->second.close / it_15m->second.open) - 1.0) * 100.0;
+    }
+    
+    inputs.has_relative = indicators.has_relative;
+    inputs.relative_pct = indicators.relative_1h_pct;
+    return inputs;
+}
+
+inline double momentum_1h_score(bool has_m1h, double m1h_pct, const SignalParams& p) {
+    double score = p.momentum_1h(m1h_pct);
+    
+    // Neutral if no data
+    return has_m1h ? score : 0.5;
+}
+
+inline double momentum_24h_score(double m24h_pct, const SignalParams& p) {
+    return p.momentum_24h(m24h_pct);
+}
+
+inline double volatility_score(bool has_range, double range_pct) {
+    double score = kVolatilityCurve(range_pct);
+    
+    // Neutral if no data
+    return has_range ? score : 0.5;
+}
+
+inline double relative_strength_score(bool has_relative, double relative_pct) {
+    double score = kRelativeStrengthCurve(relative_pct);
+    
+    // Until this mint's and SOL's histories are warm, keep the old fixed score
+    return has_relative ? score : 0.7;
+}
+
+inline double price_discovery_score(double s2, double s5) {
+    // Good when there's high volume and moderate volatility
+    return 0.4 * s2 + 0.6 * kDiscoveryVolatilityCap(s5);
+}
+
+inline double rug_risk_score(bool has_metadata, double age_hours, double top_holder_pct, bool risky_authorities) {
+    // Younger tokens and concentrated holdings are riskier
+    double age_factor = kAgeFactorCurve(age_hours);
+    double holder_factor = kHolderFactorCurve(top_holder_pct);
+    double auth_factor = risky_authorities ? 0.7 : 1.0;
+    
+    // Without metadata, be more conservative
+    double combined = 0.7 * age_factor * holder_factor * auth_factor;
+    double score = has_metadata ? combined : 0.5;
+    
+    // Cap at 0.9 - there's always some risk
+    return std::min(0.9, score);
+}
+
+inline double tradability_score(double spread_pct, double impact_pct, const SignalParams& p) {
+    // Lower spread and impact are better
+    double score = 0.4 * p.spread(spread_pct) + 0.6 * p.impact(impact_pct);
+    
+    bool rejected = spread_pct > p.max_spread_pct || impact_pct > p.max_impact_pct;
+    return rejected ? 0.0 : score;
+}
+
+inline double route_score(bool ok, double hops, double deviation_pct, const SignalParams& p) {
+    // Fewer hops and lower deviation are better
+    double score = 0.3 * p.route_hops(hops) + 0.7 * p.route_deviation(deviation_pct);
+    
+    bool rejected = !ok || hops > p.max_route_hops || deviation_pct > p.max_route_deviation;
+    return rejected ? 0.0 : score;
+}
+
+inline double data_quality_score(double liq, double vol, bool has_5m, bool has_15m,
+                                 double spread_pct, double impact_pct, const SignalParams& p) {
+    // One penalty per missing or reconstructed input
+    double dq = p.dq_start;
+    dq -= liq <= 0 ? p.dq_penalty_per_missing : 0.0;
+    dq -= vol <= 0 ? p.dq_penalty_per_missing : 0.0;
+    dq -= !has_5m ? p.dq_penalty_per_missing : 0.0;
+    dq -= !has_15m ? p.dq_penalty_per_missing : 0.0;
+    dq -= spread_pct <= 0 ? p.dq_penalty_per_missing : 0.0;
+    dq -= impact_pct <= 0 ? p.dq_penalty_per_missing : 0.0;
+    
+    // Cap at 0
+    return std::max(0.0, dq);
+}
+
+} // namespace
+
+SignalParams SignalParams::from_config(const Config& config) {
+    config.validate();
+    
+    // Liquidity and volume score zero below the heads-up minimum, then step
+    // up to 0.3 there
+    double liq_headsup = config.min_liquidity_headsup;
+    double vol_headsup = config.min_volume_headsup;
+    
+    // The fixed breakpoints give way to the configured ones around them, so
+    // every Config that passes validate() makes ordered curves and settings
+    // the old if/else chains took (MAX_M1H_PCT=5, say) still load; a segment
+    // squeezed to zero width becomes a step
+    double liq_500k = std::max(500000.0, config.min_liquidity_actionable);
+    double liq_1m = std::max(1000000.0, liq_500k);
+    double liq_2m = std::max(2000000.0, liq_1m);
+    double vol_2m = std::max(2000000.0, config.min_volume_actionable);
+    double vol_5m = std::max(5000000.0, vol_2m);
+    double vol_10m = std::max(10000000.0, vol_5m);
+    
+    double m1h_flat = std::min(0.0, config.min_m1h_pct);
+    double m1h_down = std::min(-5.0, m1h_flat);
+    double m1h_floor = std::min(-10.0, m1h_down);
+    double m1h_strong = std::min(std::max(6.0, config.min_m1h_pct), config.max_m1h_pct);
+    double m24h_flat = std::min(0.0, config.min_m24h_pct);
+    double m24h_down = std::min(-10.0, m24h_flat);
+    double m24h_floor = std::min(-30.0, m24h_down);
+    double m24h_strong = std::min(std::max(20.0, config.min_m24h_pct), config.max_m24h_pct);
+    
+    return SignalParams{
+        PiecewiseLinear<7>({
+            {0.0, 0.0}, {liq_headsup, 0.0}, {liq_headsup, 0.3},
+            {config.min_liquidity_actionable, 0.5},
+            {liq_500k, 0.8}, {liq_1m, 0.9}, {liq_2m, 1.0}
+        }),
+        PiecewiseLinear<7>({
+            {0.0, 0.0}, {vol_headsup, 0.0}, {vol_headsup, 0.3},
+            {config.min_volume_actionable, 0.5},
+            {vol_2m, 0.8}, {vol_5m, 0.9}, {vol_10m, 1.0}
+        }),
+        PiecewiseLinear<6>({
+            {m1h_floor, 0.0}, {m1h_down, 0.3}, {m1h_flat, 0.5},
+            {config.min_m1h_pct, 0.7}, {m1h_strong, 0.9}, {config.max_m1h_pct, 1.0}
+        }),
+        PiecewiseLinear<6>({
+            {m24h_floor, 0.0}, {m24h_down, 0.3}, {m24h_flat, 0.5},
+            {config.min_m24h_pct, 0.7}, {m24h_strong, 0.9}, {config.max_m24h_pct, 1.0}
+        }),
+        PiecewiseLinear<2>({{0.0, 1.0}, {config.max_spread_pct, 0.0}}),
+        PiecewiseLinear<2>({{0.0, 1.0}, {config.max_impact_pct, 0.0}}),
+        PiecewiseLinear<2>({{1.0, 1.0}, {static_cast<double>(config.max_route_hops), 0.0}}),
+        PiecewiseLinear<2>({{0.0, 1.0}, {config.max_route_deviation, 0.0}}),
+        config.max_spread_pct,
+        config.max_impact_pct,
+        config.max_route_hops,
+        config.max_route_deviation,
+        config.dq_start,
+        config.dq_penalty_per_missing
+    };
+}
+
+void SignalBatch::reserve(size_t n) {
+    for (auto* column : {&liq_usd, &vol24h_usd, &spread_pct, &impact_1pct_pct, &age_hours,
+                         &m1h_pct, &m24h_pct, &range_pct, &relative_pct,
+                         &route_hops, &route_deviation_pct, &top_holder_pct}) {
+        column->reserve(n);
+    }
+    for (auto* flags : {&has_5m, &has_15m, &has_m1h, &has_range, &has_relative,
+                        &route_ok, &has_metadata, &risky_authorities}) {
+        flags->reserve(n);
+    }
+}
+
+void SignalBatch::clear() {
+    for (auto* column : {&liq_usd, &vol24h_usd, &spread_pct, &impact_1pct_pct, &age_hours,
+                         &m1h_pct, &m24h_pct, &range_pct, &relative_pct,
+                         &route_hops, &route_deviation_pct, &top_holder_pct}) {
+        column->clear();
+    }
+    for (auto* flags : {&has_5m, &has_15m, &has_m1h, &has_range, &has_relative,
+                        &route_ok, &has_metadata, &risky_authorities}) {
+        flags->clear();
+    }
+}
+
+void SignalBatch::push_back(const MarketUpdate& update, const std::optional<TokenMetadata>& metadata,
+                            const PriceIndicators& indicators) {
+    liq_usd.push_back(update.liq_usd);
+    vol24h_usd.push_back(update.vol24h_usd);
+    spread_pct.push_back(update.spread_pct);
+    impact_1pct_pct.push_back(update.impact_1pct_pct);
+    age_hours.push_back(update.age_hours);
+    
+    has_5m.push_back(update.bars.find("5m") != update.bars.end());
+    has_15m.push_back(update.bars.find("15m") != update.bars.end());
+    
+    auto inputs = momentum_inputs(update, indicators);
+    has_m1h.push_back(inputs.has_m1h);
+    m1h_pct.push_back(inputs.m1h_pct);
+    m24h_pct.push_back(inputs.m24h_pct);
+    has_range.push_back(inputs.has_range);
+    range_pct.push_back(inputs.range_pct);
+    has_relative.push_back(inputs.has_relative);
+    relative_pct.push_back(inputs.relative_pct);
+    
+    route_ok.push_back(update.route.ok);
+    route_hops.push_back(static_cast<double>(update.route.hops));
+    route_deviation_pct.push_back(update.route.deviation_pct);
+    
+    has_metadata.push_back(metadata.has_value());
+    top_holder_pct.push_back(metadata ? metadata->top_holder_pct : 0.0);
+    risky_authorities.push_back(metadata && metadata->risky_authorities);
+}
+
+void SignalBatchResult::resize(size_t n) {
+    for (auto* column : {&s1_liquidity, &s2_volume, &s3_momentum_1h, &s4_momentum_24h, &s5_volatility,
+                         &s6_price_discovery, &s7_rug_risk, &s8_tradability, &s9_relative_strength,
+                         &s10_route_quality, &data_quality}) {
+        column->resize(n);
+    }
+}
+
+SignalCalculator::SignalCalculator(const Config& config)
+    : config_(config), params_(SignalParams::from_config(config)) {}
 
 SignalResult SignalCalculator::calculate_signals(
     const MarketUpdate& update,
     const std::optional<TokenMetadata>& metadata,
-    const std::vector<std::string>& token_list_mints
+    const TokenListIndex& token_list,
+    const PriceIndicators& indicators
 ) {
     SignalResult result;
+    auto inputs = momentum_inputs(update, indicators);
     
     // Calculate individual signals
     result.s1_liquidity = calculate_s1_liquidity(update);
     result.s2_volume = calculate_s2_volume(update);
-    result.s3_momentum_1h = calculate_s3_momentum_1h(update);
-    result.s4_momentum_24h = calculate_s4_momentum_24h(update);
-    result.s5_volatility = calculate_s5_volatility(update);
-    result.s6_price_discovery = calculate_s6_price_discovery(update);
+    result.s3_momentum_1h = momentum_1h_score(inputs.has_m1h, inputs.m1h_pct, params_);
+    result.s4_momentum_24h = momentum_24h_score(inputs.m24h_pct, params_);
+    result.s5_volatility = volatility_score(inputs.has_range, inputs.range_pct);
+    result.s6_price_discovery = price_discovery_score(result.s2_volume, result.s5_volatility);
     result.s7_rug_risk = calculate_s7_rug_risk(update, metadata);
     result.s8_tradability = calculate_s8_tradability(update);
-    result.s9_relative_strength = calculate_s9_relative_strength(update);
+    result.s9_relative_strength = relative_strength_score(inputs.has_relative, inputs.relative_pct);
     result.s10_route_quality = calculate_s10_route_quality(update);
-    result.n1_hygiene = calculate_n1_hygiene(update.mint_base, token_list_mints);
+    result.n1_hygiene = calculate_n1_hygiene(update.mint_base, token_list);
     
     // Calculate data quality
     result.data_quality = calculate_data_quality(update);
@@ -35,309 +308,154 @@ SignalResult SignalCalculator::calculate_signals(
     return result;
 }
 
-double SignalCalculator::calculate_s1_liquidity(const MarketUpdate& update) {
-    // S1: Liquidity score
-    if (update.liq_usd <= 0) {
-        return 0.0;
+void SignalCalculator::calculate_batch(const SignalBatch& batch, SignalBatchResult& result) const {
+    const SignalParams p = params_;
+    const size_t n = batch.size();
+    result.resize(n);
+    
+    // One loop per signal keeps each loop body small enough to vectorize
+    const double* liq = batch.liq_usd.data();
+    const double* vol = batch.vol24h_usd.data();
+    const double* spread = batch.spread_pct.data();
+    const double* impact = batch.impact_1pct_pct.data();
+    const double* age = batch.age_hours.data();
+    const uint8_t* has_5m = batch.has_5m.data();
+    const uint8_t* has_15m = batch.has_15m.data();
+    const uint8_t* has_m1h = batch.has_m1h.data();
+    const double* m1h = batch.m1h_pct.data();
+    const double* m24h = batch.m24h_pct.data();
+    const uint8_t* has_range = batch.has_range.data();
+    const double* range = batch.range_pct.data();
+    const uint8_t* has_relative = batch.has_relative.data();
+    const double* relative = batch.relative_pct.data();
+    const uint8_t* route_ok = batch.route_ok.data();
+    const double* hops = batch.route_hops.data();
+    const double* deviation = batch.route_deviation_pct.data();
+    const uint8_t* has_metadata = batch.has_metadata.data();
+    const double* top_holder = batch.top_holder_pct.data();
+    const uint8_t* risky = batch.risky_authorities.data();
+    
+    double* s1 = result.s1_liquidity.data();
+    double* s2 = result.s2_volume.data();
+    double* s3 = result.s3_momentum_1h.data();
+    double* s4 = result.s4_momentum_24h.data();
+    double* s5 = result.s5_volatility.data();
+    double* s6 = result.s6_price_discovery.data();
+    double* s7 = result.s7_rug_risk.data();
+    double* s8 = result.s8_tradability.data();
+    double* s9 = result.s9_relative_strength.data();
+    double* s10 = result.s10_route_quality.data();
+    double* dq = result.data_quality.data();
+    
+    for (size_t i = 0; i < n; ++i) {
+        s1[i] = p.liquidity(liq[i]);
     }
-    
-    // Normalize liquidity on a 0-1 scale
-    // 0.0 at 0 USD
-    // 0.5 at min_liquidity_actionable (150k)
-    // 0.8 at 500k
-    // 0.9 at 1M
-    // 1.0 at 2M+
-    
-    if (update.liq_usd < config_.min_liquidity_headsup) {
-        return 0.0;
-    } else if (update.liq_usd < config_.min_liquidity_actionable) {
-        return 0.3 + 0.2 * (update.liq_usd - config_.min_liquidity_headsup) / 
-                          (config_.min_liquidity_actionable - config_.min_liquidity_headsup);
-    } else if (update.liq_usd < 500000) {
-        return 0.5 + 0.3 * (update.liq_usd - config_.min_liquidity_actionable) / 
-                          (500000 - config_.min_liquidity_actionable);
-    } else if (update.liq_usd < 1000000) {
-        return 0.8 + 0.1 * (update.liq_usd - 500000) / 500000;
-    } else if (update.liq_usd < 2000000) {
-        return 0.9 + 0.1 * (update.liq_usd - 1000000) / 1000000;
-    } else {
-        return 1.0;
+    for (size_t i = 0; i < n; ++i) {
+        s2[i] = p.volume(vol[i]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s3[i] = momentum_1h_score(has_m1h[i] != 0, m1h[i], p);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s4[i] = momentum_24h_score(m24h[i], p);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s5[i] = volatility_score(has_range[i] != 0, range[i]);
     }
+    for (size_t i = 0; i < n; ++i) {
+        s6[i] = price_discovery_score(s2[i], s5[i]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s7[i] = rug_risk_score(has_metadata[i] != 0, age[i], top_holder[i], risky[i] != 0);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s8[i] = tradability_score(spread[i], impact[i], p);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s9[i] = relative_strength_score(has_relative[i] != 0, relative[i]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s10[i] = route_score(route_ok[i] != 0, hops[i], deviation[i], p);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        dq[i] = data_quality_score(liq[i], vol[i], has_5m[i] != 0, has_15m[i] != 0, spread[i], impact[i], p);
+    }
+}
+
+double SignalCalculator::calculate_s1_liquidity(const MarketUpdate& update) {
+    // S1: Liquidity score
+    return params_.liquidity(update.liq_usd);
 }
 
 double SignalCalculator::calculate_s2_volume(const MarketUpdate& update) {
     // S2: Volume score
-    if (update.vol24h_usd <= 0) {
-        return 0.0;
-    }
-    
-    // Normalize volume on a 0-1 scale
-    // 0.0 at 0 USD
-    // 0.5 at min_volume_actionable (500k)
-    // 0.8 at 2M
-    // 0.9 at 5M
-    // 1.0 at 10M+
-    
-    if (update.vol24h_usd < config_.min_volume_headsup) {
-        return 0.0;
-    } else if (update.vol24h_usd < config_.min_volume_actionable) {
-        return 0.3 + 0.2 * (update.vol24h_usd - config_.min_volume_headsup) / 
-                          (config_.min_volume_actionable - config_.min_volume_headsup);
-    } else if (update.vol24h_usd < 2000000) {
-        return 0.5 + 0.3 * (update.vol24h_usd - config_.min_volume_actionable) / 
-                          (2000000 - config_.min_volume_actionable);
-    } else if (update.vol24h_usd < 5000000) {
-        return 0.8 + 0.1 * (update.vol24h_usd - 2000000) / 3000000;
-    } else if (update.vol24h_usd < 10000000) {
-        return 0.9 + 0.1 * (update.vol24h_usd - 5000000) / 5000000;
-    } else {
-        return 1.0;
-    }
+    return params_.volume(update.vol24h_usd);
 }
 
-double SignalCalculator::calculate_s3_momentum_1h(const MarketUpdate& update) {
+double SignalCalculator::calculate_s3_momentum_1h(const MarketUpdate& update, const PriceIndicators& indicators) {
     // S3: 1-hour momentum score
-    auto it = update.bars.find("5m");
-    if (it == update.bars.end()) {
-        return 0.5; // Neutral if no data
-    }
-    
-    const auto& bar_5m = it->second;
-    
-    // Calculate 1h momentum using 5m bar
-    double m1h_pct = ((bar_5m.close / bar_5m.open) - 1.0) * 100.0;
-    
-    // Normalize momentum on a 0-1 scale
-    // 0.0 at -10% or worse
-    // 0.3 at -5%
-    // 0.5 at 0%
-    // 0.7 at +1% (min_m1h_pct)
-    // 0.9 at +6%
-    // 1.0 at +12% (max_m1h_pct) or better
-    
-    if (m1h_pct <= -10.0) {
-        return 0.0;
-    } else if (m1h_pct <= -5.0) {
-        return 0.0 + 0.3 * (m1h_pct + 10.0) / 5.0;
-    } else if (m1h_pct <= 0.0) {
-        return 0.3 + 0.2 * (m1h_pct + 5.0) / 5.0;
-    } else if (m1h_pct < config_.min_m1h_pct) {
-        return 0.5 + 0.2 * m1h_pct / config_.min_m1h_pct;
-    } else if (m1h_pct <= 6.0) {
-        return 0.7 + 0.2 * (m1h_pct - config_.min_m1h_pct) / (6.0 - config_.min_m1h_pct);
-    } else if (m1h_pct <= config_.max_m1h_pct) {
-        return 0.9 + 0.1 * (m1h_pct - 6.0) / (config_.max_m1h_pct - 6.0);
-    } else {
-        return 1.0;
-    }
+    auto inputs = momentum_inputs(update, indicators);
+    return momentum_1h_score(inputs.has_m1h, inputs.m1h_pct, params_);
 }
 
-double SignalCalculator::calculate_s4_momentum_24h(const MarketUpdate& update) {
+double SignalCalculator::calculate_s4_momentum_24h(const MarketUpdate& update, const PriceIndicators& indicators) {
     // S4: 24-hour momentum score
-    // For simplicity, we'll use the 24h change directly
-    // In a real implementation, you might want to use OHLCV data
-    
-    // Normalize momentum on a 0-1 scale
-    // 0.0 at -30% or worse
-    // 0.3 at -10%
-    // 0.5 at 0%
-    // 0.7 at +2% (min_m24h_pct)
-    // 0.9 at +20%
-    // 1.0 at +60% (max_m24h_pct) or better
-    
-    // Assuming we have a 24h change percentage
-    double m24h_pct = 0.0;
-    
-    // Try to extract from bars if available
-    auto it = update.bars.find("15m");
-    if (it != update.bars.end()) {
-        const auto& bar_15m = it->second;
-        m24h_pct = ((bar_15m.close / bar_15m.open) - 1.0) * 100.0;
-    }
-    
-    if (m24h_pct <= -30.0) {
-        return 0.0;
-    } else if (m24h_pct <= -10.0) {
-        return 0.0 + 0.3 * (m24h_pct + 30.0) / 20.0;
-    } else if (m24h_pct <= 0.0) {
-        return 0.3 + 0.2 * (m24h_pct + 10.0) / 10.0;
-    } else if (m24h_pct < config_.min_m24h_pct) {
-        return 0.5 + 0.2 * m24h_pct / config_.min_m24h_pct;
-    } else if (m24h_pct <= 20.0) {
-        return 0.7 + 0.2 * (m24h_pct - config_.min_m24h_pct) / (20.0 - config_.min_m24h_pct);
-    } else if (m24h_pct <= config_.max_m24h_pct) {
-        return 0.9 + 0.1 * (m24h_pct - 20.0) / (config_.max_m24h_pct - 20.0);
-    } else {
-        return 1.0;
-    }
+    auto inputs = momentum_inputs(update, indicators);
+    return momentum_24h_score(inputs.m24h_pct, params_);
 }
 
-double SignalCalculator::calculate_s5_volatility(const MarketUpdate& update) {
-    // S5: Volatility score
-    // For simplicity, we'll use the high-low range from the 15m bar
-    
-    auto it = update.bars.find("15m");
-    if (it == update.bars.end()) {
-        return 0.5; // Neutral if no data
-    }
-    
-    const auto& bar_15m = it->second;
-    
-    // Calculate volatility as (high-low)/low
-    double volatility = ((bar_15m.high - bar_15m.low) / bar_15m.low) * 100.0;
-    
-    // Normalize volatility on a 0-1 scale
-    // 0.0 at 0% (no volatility)
-    // 0.5 at 5%
-    // 0.8 at 10%
-    // 1.0 at 20%+
-    
-    if (volatility <= 0.0) {
-        return 0.0;
-    } else if (volatility <= 5.0) {
-        return 0.0 + 0.5 * volatility / 5.0;
-    } else if (volatility <= 10.0) {
-        return 0.5 + 0.3 * (volatility - 5.0) / 5.0;
-    } else if (volatility <= 20.0) {
-        return 0.8 + 0.2 * (volatility - 10.0) / 10.0;
-    } else {
-        return 1.0;
-    }
+double SignalCalculator::calculate_s5_volatility(const MarketUpdate& update, const PriceIndicators& indicators) {
+    // S5: Volatility score from the 1h high-low range
+    auto inputs = momentum_inputs(update, indicators);
+    return volatility_score(inputs.has_range, inputs.range_pct);
 }
 
-double SignalCalculator::calculate_s6_price_discovery(const MarketUpdate& update) {
+double SignalCalculator::calculate_s6_price_discovery(const MarketUpdate& update, const PriceIndicators& indicators) {
     // S6: Price discovery score
-    // This is a more complex signal that might involve looking at price action patterns
-    // For simplicity, we'll use a combination of volume and volatility
-    
-    double s2 = calculate_s2_volume(update);
-    double s5 = calculate_s5_volatility(update);
-    
-    // Price discovery is good when there's high volume and moderate volatility
-    return 0.4 * s2 + 0.6 * std::min(s5, 0.8);
+    // For simplicity, we use a combination of volume and volatility
+    return price_discovery_score(calculate_s2_volume(update), calculate_s5_volatility(update, indicators));
 }
 
 double SignalCalculator::calculate_s7_rug_risk(const MarketUpdate& update, const std::optional<TokenMetadata>& metadata) {
     // S7: Rug risk score (higher is better, meaning lower risk)
-    
-    // Start with a base score
-    double score = 0.7;
-    
-    // If we have metadata, adjust based on token properties
-    if (metadata) {
-        // Age factor: younger tokens are riskier
-        double age_factor = std::min(1.0, update.age_hours / 720.0); // 30 days = 720 hours
-        
-        // Top holder concentration: higher is riskier
-        double holder_factor = 1.0;
-        if (metadata->top_holder_pct > 0) {
-            holder_factor = std::max(0.0, 1.0 - metadata->top_holder_pct / 100.0);
-        }
-        
-        // Risky authorities
-        double auth_factor = metadata->risky_authorities ? 0.7 : 1.0;
-        
-        // Combine factors
-        score = 0.7 * age_factor * holder_factor * auth_factor;
-    } else {
-        // Without metadata, be more conservative
-        score = 0.5;
-    }
-    
-    // Cap at 0.9 - there's always some risk
-    return std::min(0.9, score);
+    return rug_risk_score(metadata.has_value(), update.age_hours,
+                          metadata ? metadata->top_holder_pct : 0.0,
+                          metadata && metadata->risky_authorities);
 }
 
 double SignalCalculator::calculate_s8_tradability(const MarketUpdate& update) {
     // S8: Tradability score based on spread and impact
-    
-    // Check if spread and impact are within acceptable ranges
-    if (update.spread_pct > config_.max_spread_pct || 
-        update.impact_1pct_pct > config_.max_impact_pct) {
-        return 0.0;
-    }
-    
-    // Normalize spread (lower is better)
-    double spread_score = 1.0 - (update.spread_pct / config_.max_spread_pct);
-    
-    // Normalize impact (lower is better)
-    double impact_score = 1.0 - (update.impact_1pct_pct / config_.max_impact_pct);
-    
-    // Combine scores (weighted average)
-    return 0.4 * spread_score + 0.6 * impact_score;
+    return tradability_score(update.spread_pct, update.impact_1pct_pct, params_);
 }
 
-double SignalCalculator::calculate_s9_relative_strength(const MarketUpdate& update) {
-    // S9: Relative strength compared to market
-    // This would typically compare the token's performance to SOL or a basket
-    // For simplicity, we'll use a placeholder value
-    return 0.7;
+double SignalCalculator::calculate_s9_relative_strength(const PriceIndicators& indicators) {
+    // S9: Relative strength, 1h return against SOL's
+    return relative_strength_score(indicators.has_relative, indicators.relative_1h_pct);
 }
 
 double SignalCalculator::calculate_s10_route_quality(const MarketUpdate& update) {
     // S10: Route quality score
-    
-    // Check if route meets requirements
-    if (!update.route.ok || 
-        update.route.hops > config_.max_route_hops || 
-        update.route.deviation_pct > config_.max_route_deviation) {
-        return 0.0;
-    }
-    
-    // Normalize hops (fewer is better)
-    double hops_score = 1.0 - ((double)update.route.hops - 1.0) / (config_.max_route_hops - 1.0);
-    
-    // Normalize deviation (lower is better)
-    double deviation_score = 1.0 - (update.route.deviation_pct / config_.max_route_deviation);
-    
-    // Combine scores (weighted average)
-    return 0.3 * hops_score + 0.7 * deviation_score;
+    return route_score(update.route.ok, static_cast<double>(update.route.hops),
+                       update.route.deviation_pct, params_);
 }
 
-double SignalCalculator::calculate_n1_hygiene(const std::string& mint, const std::vector<std::string>& token_list_mints) {
+double SignalCalculator::calculate_n1_hygiene(const std::string& mint, const TokenListIndex& token_list) {
     // N1: Token list hygiene
     // Check if the token is on a widely mirrored list
     
-    for (const auto& list_mint : token_list_mints) {
-        if (list_mint == mint) {
-            return 1.0; // Token is on a recognized list
-        }
+    if (token_list.contains(mint)) {
+        return 1.0; // Token is on a recognized list
     }
     
     return 0.0; // Token is not on any recognized list
 }
 
 double SignalCalculator::calculate_data_quality(const MarketUpdate& update) {
-    // Start with perfect data quality
-    double dq = config_.dq_start;
-    
-    // Check for missing or reconstructed data
-    if (update.liq_usd <= 0) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    if (update.vol24h_usd <= 0) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    if (update.bars.find("5m") == update.bars.end()) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    if (update.bars.find("15m") == update.bars.end()) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    if (update.spread_pct <= 0) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    if (update.impact_1pct_pct <= 0) {
-        dq -= config_.dq_penalty_per_missing;
-    }
-    
-    // Cap at 0
-    return std::max(0.0, dq);
+    // Start with perfect data quality and penalize missing or reconstructed data
+    return data_quality_score(update.liq_usd, update.vol24h_usd,
+                              update.bars.find("5m") != update.bars.end(),
+                              update.bars.find("15m") != update.bars.end(),
+                              update.spread_pct, update.impact_1pct_pct, params_);
 }
 
 std::vector<std::string> SignalCalculator::generate_reasons(
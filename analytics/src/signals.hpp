@@ -2,34 +2,125 @@
 
 #include "types.hpp"
 #include "config.hpp"
+#include "token_list_index.hpp"
+#include "piecewise_linear.hpp"
+#include "price_history.hpp"
 #include <optional>
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
+
+// Market updates laid out column by column, so the batch kernel streams each
+// input once and the compiler can vectorize every signal loop. Momentum,
+// range and relative strength are stored already resolved from the price
+// history or the bars; missing inputs are carried as 0/1 flags next to
+// placeholder values.
+struct SignalBatch {
+    std::vector<double> liq_usd;
+    std::vector<double> vol24h_usd;
+    std::vector<double> spread_pct;
+    std::vector<double> impact_1pct_pct;
+    std::vector<double> age_hours;
+    
+    std::vector<uint8_t> has_5m;
+    std::vector<uint8_t> has_15m;
+    
+    std::vector<uint8_t> has_m1h;
+    std::vector<double> m1h_pct;
+    std::vector<double> m24h_pct;
+    std::vector<uint8_t> has_range;
+    std::vector<double> range_pct;
+    std::vector<uint8_t> has_relative;
+    std::vector<double> relative_pct;
+    
+    std::vector<uint8_t> route_ok;
+    std::vector<double> route_hops;
+    std::vector<double> route_deviation_pct;
+    
+    std::vector<uint8_t> has_metadata;
+    std::vector<double> top_holder_pct;
+    std::vector<uint8_t> risky_authorities;
+    
+    size_t size() const { return liq_usd.size(); }
+    void reserve(size_t n);
+    void clear();
+    void push_back(const MarketUpdate& update, const std::optional<TokenMetadata>& metadata,
+                   const PriceIndicators& indicators);
+};
+
+// Per-update signals of a batch, indexed like the SignalBatch rows
+struct SignalBatchResult {
+    std::vector<double> s1_liquidity;
+    std::vector<double> s2_volume;
+    std::vector<double> s3_momentum_1h;
+    std::vector<double> s4_momentum_24h;
+    std::vector<double> s5_volatility;
+    std::vector<double> s6_price_discovery;
+    std::vector<double> s7_rug_risk;
+    std::vector<double> s8_tradability;
+    std::vector<double> s9_relative_strength;
+    std::vector<double> s10_route_quality;
+    std::vector<double> data_quality;
+    
+    void resize(size_t n);
+};
+
+// The signal curves whose breakpoints come from Config, built once at
+// startup, plus the other Config values the kernels read. The batch loops
+// work on a local copy, which the compiler knows the output columns cannot
+// alias.
+struct SignalParams {
+    PiecewiseLinear<7> liquidity;     // S1, by liquidity USD
+    PiecewiseLinear<7> volume;        // S2, by 24h volume USD
+    PiecewiseLinear<6> momentum_1h;   // S3, by 5m bar change %
+    PiecewiseLinear<6> momentum_24h;  // S4, by 15m bar change %
+    PiecewiseLinear<2> spread;        // S8 spread component, by spread %
+    PiecewiseLinear<2> impact;        // S8 impact component, by 1% impact %
+    PiecewiseLinear<2> route_hops;    // S10 hops component
+    PiecewiseLinear<2> route_deviation;  // S10 deviation component, by deviation %
+    
+    double max_spread_pct;
+    double max_impact_pct;
+    int max_route_hops;
+    double max_route_deviation;
+    double dq_start;
+    double dq_penalty_per_missing;
+    
+    static SignalParams from_config(const Config& config);
+};
 
 class SignalCalculator {
 public:
     explicit SignalCalculator(const Config& config);
     
-    // Calculate all signals for a market update
+    // Calculate all signals for a market update. S3-S6 and S9 use the
+    // mint's rolling windows once they hold enough bars and fall back to
+    // the update's own 5m/15m bars until then.
     SignalResult calculate_signals(
         const MarketUpdate& update,
         const std::optional<TokenMetadata>& metadata,
-        const std::vector<std::string>& token_list_mints
+        const TokenListIndex& token_list,
+        const PriceIndicators& indicators
     );
     
+    // Numeric signals (everything but N1 and the reasons) for a whole batch.
+    // Branch-free and bit-for-bit equal to the per-update functions below,
+    // which evaluate the same kernels one element at a time.
+    void calculate_batch(const SignalBatch& batch, SignalBatchResult& result) const;
+    
     // Individual signal calculations
     double calculate_s1_liquidity(const MarketUpdate& update);
     double calculate_s2_volume(const MarketUpdate& update);
-    double calculate_s3_momentum_1h(const MarketUpdate& update);
-    double calculate_s4_momentum_24h(const MarketUpdate& update);
-    double calculate_s5_volatility(const MarketUpdate& update);
-    double calculate_s6_price_discovery(const MarketUpdate& update);
+    double calculate_s3_momentum_1h(const MarketUpdate& update, const PriceIndicators& indicators);
+    double calculate_s4_momentum_24h(const MarketUpdate& update, const PriceIndicators& indicators);
+    double calculate_s5_volatility(const MarketUpdate& update, const PriceIndicators& indicators);
+    double calculate_s6_price_discovery(const MarketUpdate& update, const PriceIndicators& indicators);
     double calculate_s7_rug_risk(const MarketUpdate& update, const std::optional<TokenMetadata>& metadata);
     double calculate_s8_tradability(const MarketUpdate& update);
-    double calculate_s9_relative_strength(const MarketUpdate& update);
+    double calculate_s9_relative_strength(const PriceIndicators& indicators);
     double calculate_s10_route_quality(const MarketUpdate& update);
-    double calculate_n1_hygiene(const std::string& mint, const std::vector<std::string>& token_list_mints);
+    double calculate_n1_hygiene(const std::string& mint, const TokenListIndex& token_list);
     
     // Data quality assessment
     double calculate_data_quality(const MarketUpdate& update);
@@ -43,4 +134,5 @@ public:
 
 private:
     const Config& config_;
+    SignalParams params_;
 };
@@ -1,80 +1,134 @@
-
 #include "throttles.hpp"
 #include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr size_t kHighConviction = 0;
+constexpr size_t kActionable = 1;
+constexpr size_t kHeadsUp = 2;
+constexpr size_t kWatch = 3;
+
+const char* const kBandNames[] = {"high_conviction", "actionable", "heads_up", "watch"};
+
+// Expired last-alert entries are swept at most this often
+constexpr auto kCleanupInterval = std::chrono::minutes(1);
+
+// Unknown bands are throttled like watch, as before
+size_t band_index(const std::string& band) {
+    if (band == "high_conviction") {
+        return kHighConviction;
+    } else if (band == "actionable") {
+        return kActionable;
+    } else if (band == "heads_up") {
+        return kHeadsUp;
+    }
+    return kWatch;
+}
+
+int cooldown_minutes(const Config& config, size_t band) {
+    switch (band) {
+        case kHighConviction: return config.cooldown_high_conviction_min;
+        case kActionable: return config.cooldown_actionable_min;
+        case kHeadsUp: return config.cooldown_headsup_min;
+        default: return config.cooldown_watch_min;
+    }
+}
 
-ThrottleManager::ThrottleManager(const Config& config) : config_(config) {}
+int max_band_alerts(const Config& config, size_t band) {
+    switch (band) {
+        case kHighConviction: return config.max_high_conviction_per_window;
+        case kActionable: return config.max_actionable_per_window;
+        case kHeadsUp: return config.max_headsup_per_window;
+        default: return config.max_watch_per_window;
+    }
+}
+
+int max_cooldown_minutes(const Config& config) {
+    return std::max({
+        config.cooldown_high_conviction_min,
+        config.cooldown_actionable_min,
+        config.cooldown_headsup_min,
+        config.cooldown_watch_min
+    });
+}
+
+int64_t epoch_minute(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::minutes>(tp.time_since_epoch()).count();
+}
+
+int64_t to_ms(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_ms(int64_t ms) {
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+}
+
+// Write atomically (temp file + rename) so a crash cannot leave a truncated file
+void write_state_file(const std::string& path, const json& doc) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) {
+            spdlog::warn("Cannot open throttle state {} for writing", tmp_path);
+            return;
+        }
+        out << doc.dump();
+        if (!out.good()) {
+            spdlog::warn("Failed to write throttle state {}", tmp_path);
+            return;
+        }
+    }
+    
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        spdlog::warn("Failed to move throttle state into place at {}", path);
+    }
+}
+
+} // namespace
+
+ThrottleManager::ThrottleManager(const Config& config)
+    : config_(config), window_(static_cast<size_t>(std::max(1, config.rate_limit_window_min))) {
+    load_state();
+}
 
 bool ThrottleManager::should_throttle(const std::string& mint, const std::string& band) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     auto now = std::chrono::system_clock::now();
+    size_t band_idx = band_index(band);
     
     // Check if we've sent an alert for this mint recently
-    for (const auto& record : alert_history_) {
-        if (record.mint == mint) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - record.timestamp).count();
-            
-            // Different cooldown periods based on band
-            int cooldown_minutes = 0;
-            if (band == "high_conviction") {
-                cooldown_minutes = config_.cooldown_high_conviction_min;
-            } else if (band == "actionable") {
-                cooldown_minutes = config_.cooldown_actionable_min;
-            } else if (band == "heads_up") {
-                cooldown_minutes = config_.cooldown_headsup_min;
-            } else {
-                cooldown_minutes = config_.cooldown_watch_min;
-            }
-            
-            if (elapsed < cooldown_minutes) {
-                spdlog::debug("Throttling alert for {}: {} minutes elapsed, cooldown is {} minutes",
-                             mint, elapsed, cooldown_minutes);
-                return true;
-            }
+    auto it = last_alerts_.find(mint);
+    if (it != last_alerts_.end()) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - it->second.timestamp).count();
+        int cooldown = cooldown_minutes(config_, band_idx);
+        if (elapsed < cooldown) {
+            spdlog::debug("Throttling alert for {}: {} minutes elapsed, cooldown is {} minutes",
+                         mint, elapsed, cooldown);
+            return true;
         }
     }
     
-    // Check global rate limits
-    int alerts_in_window = 0;
-    for (const auto& record : alert_history_) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - record.timestamp).count();
-        if (elapsed < config_.rate_limit_window_min) {
-            alerts_in_window++;
-        }
-    }
+    advance(epoch_minute(now));
     
-    if (alerts_in_window >= config_.max_alerts_per_window) {
+    // Check global rate limits
+    if (window_total_ >= config_.max_alerts_per_window) {
         spdlog::debug("Global rate limit reached: {} alerts in {} minute window",
-                     alerts_in_window, config_.rate_limit_window_min);
+                     window_total_, config_.rate_limit_window_min);
         return true;
     }
     
     // Check band-specific rate limits
-    int band_alerts_in_window = 0;
-    for (const auto& record : alert_history_) {
-        if (record.band == band) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - record.timestamp).count();
-            if (elapsed < config_.rate_limit_window_min) {
-                band_alerts_in_window++;
-            }
-        }
-    }
-    
-    int max_band_alerts = 0;
-    if (band == "high_conviction") {
-        max_band_alerts = config_.max_high_conviction_per_window;
-    } else if (band == "actionable") {
-        max_band_alerts = config_.max_actionable_per_window;
-    } else if (band == "heads_up") {
-        max_band_alerts = config_.max_headsup_per_window;
-    } else {
-        max_band_alerts = config_.max_watch_per_window;
-    }
-    
-    if (band_alerts_in_window >= max_band_alerts) {
+    if (window_bands_[band_idx] >= max_band_alerts(config_, band_idx)) {
         spdlog::debug("Band-specific rate limit reached for {}: {} alerts in {} minute window",
-                     band, band_alerts_in_window, config_.rate_limit_window_min);
+                     band, window_bands_[band_idx], config_.rate_limit_window_min);
         return true;
     }
     
@@ -82,39 +136,161 @@ bool ThrottleManager::should_throttle(const std::string& mint, const std::string
 }
 
 void ThrottleManager::record_alert(const std::string& mint, const std::string& band) {
+    json state;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto now = std::chrono::system_clock::now();
+        size_t band_idx = band_index(band);
+        last_alerts_[mint] = LastAlert{band_idx, now};
+        
+        // A clock step backwards lands in the newest bucket
+        advance(epoch_minute(now));
+        auto& bucket = window_[static_cast<size_t>(head_minute_) % window_.size()];
+        ++bucket.total;
+        ++bucket.bands[band_idx];
+        ++window_total_;
+        ++window_bands_[band_idx];
+        
+        if (now - last_cleanup_ >= kCleanupInterval) {
+            remove_expired(now);
+        }
+        
+        if (!config_.throttle_state_file.empty()) {
+            state = snapshot(now);
+        }
+    }
+    
+    // Alerts are rare, so the whole state is rewritten each time
+    if (!state.is_null()) {
+        write_state_file(config_.throttle_state_file, state);
+    }
+}
+
+void ThrottleManager::cleanup() {
     std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::system_clock::now();
+    remove_expired(now);
+    advance(epoch_minute(now));
+}
+
+void ThrottleManager::advance(int64_t minute) {
+    if (minute <= head_minute_) {
+        return;
+    }
     
-    AlertRecord record;
-    record.mint = mint;
-    record.band = band;
-    record.timestamp = std::chrono::system_clock::now();
+    // Reuse every slot between the old head and the new one; after a gap of
+    // a full window or more that is each slot once
+    int64_t span = static_cast<int64_t>(window_.size());
+    for (int64_t m = std::max(head_minute_ + 1, minute - span + 1); m <= minute; ++m) {
+        auto& bucket = window_[static_cast<size_t>(m) % window_.size()];
+        window_total_ -= bucket.total;
+        for (size_t i = 0; i < kBands; ++i) {
+            window_bands_[i] -= bucket.bands[i];
+        }
+        bucket = Bucket{m};
+    }
+    head_minute_ = minute;
+}
+
+void ThrottleManager::remove_expired(std::chrono::system_clock::time_point now) {
+    last_cleanup_ = now;
     
-    alert_history_.push_back(record);
+    // Remove last alerts older than the maximum cooldown period
+    int max_cooldown = max_cooldown_minutes(config_);
+    for (auto it = last_alerts_.begin(); it != last_alerts_.end();) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - it->second.timestamp).count();
+        if (elapsed > max_cooldown) {
+            it = last_alerts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+json ThrottleManager::snapshot(std::chrono::system_clock::time_point now) const {
+    json doc;
+    doc["written_at"] = to_ms(now);
     
-    // Clean up old records
-    cleanup();
+    doc["last_alerts"] = json::array();
+    for (const auto& [mint, alert] : last_alerts_) {
+        doc["last_alerts"].push_back({
+            {"mint", mint},
+            {"band", kBandNames[alert.band]},
+            {"timestamp", to_ms(alert.timestamp)}
+        });
+    }
+    
+    doc["window"] = json::array();
+    for (const auto& bucket : window_) {
+        if (bucket.total == 0) {
+            continue;
+        }
+        json bands = json::object();
+        for (size_t i = 0; i < kBands; ++i) {
+            bands[kBandNames[i]] = bucket.bands[i];
+        }
+        doc["window"].push_back({
+            {"minute", bucket.minute},
+            {"bands", bands}
+        });
+    }
+    return doc;
 }
 
-void ThrottleManager::cleanup() {
-    auto now = std::chrono::system_clock::now();
+void ThrottleManager::load_state() {
+    if (config_.throttle_state_file.empty()) {
+        return;
+    }
     
-    // Remove records older than the maximum cooldown period
-    int max_cooldown = std::max({
-        config_.cooldown_high_conviction_min,
-        config_.cooldown_actionable_min,
-        config_.cooldown_headsup_min,
-        config_.cooldown_watch_min
-    });
+    std::ifstream in(config_.throttle_state_file);
+    if (!in) {
+        return;
+    }
     
-    alert_history_.erase(
-        std::remove_if(
-            alert_history_.begin(),
-            alert_history_.end(),
-            [now, max_cooldown](const AlertRecord& record) {
-                auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - record.timestamp).count();
-                return elapsed > max_cooldown;
+    try {
+        auto doc = json::parse(in);
+        auto now = std::chrono::system_clock::now();
+        int max_cooldown = max_cooldown_minutes(config_);
+        
+        for (const auto& item : doc.value("last_alerts", json::array())) {
+            auto timestamp = from_ms(item.at("timestamp").get<int64_t>());
+            if (std::chrono::duration_cast<std::chrono::minutes>(now - timestamp).count() > max_cooldown) {
+                continue;
             }
-        ),
-        alert_history_.end()
-    );
+            size_t band_idx = band_index(item.value("band", ""));
+            last_alerts_[item.at("mint").get<std::string>()] = LastAlert{band_idx, timestamp};
+        }
+        
+        // Buckets that are still inside the window go back into their slots
+        advance(epoch_minute(now));
+        int64_t span = static_cast<int64_t>(window_.size());
+        for (const auto& item : doc.value("window", json::array())) {
+            int64_t minute = item.at("minute").get<int64_t>();
+            if (minute <= head_minute_ - span || minute > head_minute_) {
+                continue;
+            }
+            auto& bucket = window_[static_cast<size_t>(minute) % window_.size()];
+            const auto& bands = item.at("bands");
+            for (size_t i = 0; i < kBands; ++i) {
+                int count = bands.value(kBandNames[i], 0);
+                bucket.bands[i] += count;
+                bucket.total += count;
+                window_bands_[i] += count;
+                window_total_ += count;
+            }
+            bucket.minute = minute;
+        }
+        
+        last_cleanup_ = now;
+        spdlog::info("Restored throttle state: {} recent alerts, {} in the {} minute window",
+                    last_alerts_.size(), window_total_, config_.rate_limit_window_min);
+    } catch (const std::exception& e) {
+        spdlog::warn("Ignoring unreadable throttle state {}: {}", config_.throttle_state_file, e.what());
+        last_alerts_.clear();
+        window_.assign(window_.size(), Bucket{});
+        head_minute_ = -1;
+        window_total_ = 0;
+        window_bands_ = {};
+    }
 }
@@ -1,14 +1,24 @@
-
 #pragma once
 
 #include "types.hpp"
 #include "config.hpp"
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
 #include <vector>
 
+// Alert throttling with constant-time decisions.
+//
+// Per-mint cooldowns look up the mint's last alert in a hash map. The global
+// and per-band caps count alerts in a ring of one-minute buckets spanning
+// rate_limit_window_min; running totals are adjusted as buckets fall out of
+// the window, so the window is exact to the minute without scanning history.
+//
+// The last alerts and the window's buckets are written to
+// throttle_state_file after every alert and read back on construction, so a
+// restart does not reopen cooldowns or reset the caps.
 class ThrottleManager {
 public:
     explicit ThrottleManager(const Config& config);
@@ -23,13 +33,36 @@ public:
     void cleanup();
 
 private:
-    struct AlertRecord {
-        std::string mint;
-        std::string band;
+    static constexpr size_t kBands = 4;
+    
+    struct LastAlert {
+        size_t band;
         std::chrono::system_clock::time_point timestamp;
     };
     
+    // Alerts recorded during one minute since the epoch
+    struct Bucket {
+        int64_t minute = -1;
+        int total = 0;
+        std::array<int, kBands> bands{};
+    };
+    
+    // Move the window's head to minute, dropping buckets that left it
+    void advance(int64_t minute);
+    
+    void remove_expired(std::chrono::system_clock::time_point now);
+    
+    nlohmann::json snapshot(std::chrono::system_clock::time_point now) const;
+    void load_state();
+    
     const Config& config_;
     std::mutex mutex_;
-    std::vector<AlertRecord> alert_history_;
+    std::unordered_map<std::string, LastAlert> last_alerts_;
+    
+    std::vector<Bucket> window_;
+    int64_t head_minute_ = -1;
+    int window_total_ = 0;
+    std::array<int, kBands> window_bands_{};
+    
+    std::chrono::system_clock::time_point last_cleanup_;
 };
@@ -0,0 +1,175 @@
+#include "token_list_index.hpp"
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+const std::string kChannel = "token_list_changed";
+
+// Row-level and filtered, so only rows whose listing actually changes notify;
+// the ingestor's routine token upserts never do. Postgres folds identical
+// notifications within a transaction, so a bulk change still sends one.
+const char* kInstallTrigger = R"(
+    CREATE OR REPLACE FUNCTION notify_token_list_changed() RETURNS trigger AS $$
+    BEGIN
+        PERFORM pg_notify('token_list_changed', '');
+        RETURN NULL;
+    END;
+    $$ LANGUAGE plpgsql;
+    
+    -- Replaced by the row-level triggers below
+    DROP TRIGGER IF EXISTS tokens_token_list_changed ON tokens;
+    
+    CREATE OR REPLACE TRIGGER tokens_token_list_inserted
+        AFTER INSERT ON tokens
+        FOR EACH ROW WHEN (NEW.on_token_list)
+        EXECUTE FUNCTION notify_token_list_changed();
+    
+    CREATE OR REPLACE TRIGGER tokens_token_list_updated
+        AFTER UPDATE OF on_token_list ON tokens
+        FOR EACH ROW WHEN (OLD.on_token_list IS DISTINCT FROM NEW.on_token_list)
+        EXECUTE FUNCTION notify_token_list_changed();
+    
+    CREATE OR REPLACE TRIGGER tokens_token_list_deleted
+        AFTER DELETE ON tokens
+        FOR EACH ROW WHEN (OLD.on_token_list)
+        EXECUTE FUNCTION notify_token_list_changed();
+)";
+
+using MintSet = std::unordered_set<std::string>;
+
+class ChangeReceiver : public pqxx::notification_receiver {
+public:
+    ChangeReceiver(pqxx::connection& conn, std::atomic<bool>& stale)
+        : pqxx::notification_receiver(conn, kChannel), stale_(stale) {}
+    
+    void operator()(const std::string&, int) override {
+        stale_ = true;
+    }
+
+private:
+    std::atomic<bool>& stale_;
+};
+
+} // namespace
+
+class TokenListIndex::Impl {
+public:
+    explicit Impl(const Config& config)
+        : config_(config), mints_(std::make_shared<const MintSet>()) {}
+    
+    ~Impl() {
+        stop();
+    }
+    
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        thread_ = std::thread(&Impl::run, this);
+    }
+    
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    
+    bool contains(const std::string& mint) const {
+        auto mints = std::atomic_load(&mints_);
+        return mints->count(mint) > 0;
+    }
+    
+    size_t size() const {
+        return std::atomic_load(&mints_)->size();
+    }
+
+private:
+    void run() {
+        auto refresh = std::chrono::seconds(std::max(1, config_.token_list_refresh_seconds));
+        
+        while (running_) {
+            try {
+                pqxx::connection conn(config_.pg_dsn);
+                install_trigger(conn);
+                ChangeReceiver receiver(conn, stale_);
+                
+                // Changes made while we were not listening are unknown
+                auto last_load = std::chrono::steady_clock::now();
+                stale_ = true;
+                
+                while (running_) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (stale_.exchange(false) || now - last_load >= refresh) {
+                        reload(conn);
+                        last_load = now;
+                    }
+                    conn.await_notification(1, 0);
+                }
+            } catch (const std::exception& e) {
+                spdlog::error("Token list index error: {}", e.what());
+                for (int i = 0; i < 5 && running_; ++i) {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                }
+            }
+        }
+    }
+    
+    void install_trigger(pqxx::connection& conn) {
+        try {
+            pqxx::work txn(conn);
+            txn.exec(kInstallTrigger);
+            txn.commit();
+        } catch (const std::exception& e) {
+            // Without the trigger the periodic refresh still keeps the set current
+            spdlog::warn("Could not install token list trigger: {}", e.what());
+        }
+    }
+    
+    void reload(pqxx::connection& conn) {
+        pqxx::work txn(conn);
+        pqxx::result result = txn.exec("SELECT mint FROM tokens WHERE on_token_list = true");
+        txn.commit();
+        
+        auto mints = std::make_shared<MintSet>();
+        mints->reserve(result.size());
+        for (const auto& row : result) {
+            mints->insert(row["mint"].as<std::string>());
+        }
+        
+        std::atomic_store(&mints_, std::shared_ptr<const MintSet>(std::move(mints)));
+        spdlog::debug("Token list index reloaded: {} mints", result.size());
+    }
+    
+    const Config& config_;
+    std::shared_ptr<const MintSet> mints_;
+    std::atomic<bool> stale_{true};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+TokenListIndex::TokenListIndex(const Config& config) : impl_(std::make_unique<Impl>(config)) {}
+
+TokenListIndex::~TokenListIndex() = default;
+
+void TokenListIndex::start() {
+    impl_->start();
+}
+
+void TokenListIndex::stop() {
+    impl_->stop();
+}
+
+bool TokenListIndex::contains(const std::string& mint) const {
+    return impl_->contains(mint);
+}
+
+size_t TokenListIndex::size() const {
+    return impl_->size();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "config.hpp"
+#include <memory>
+#include <string>
+
+// In-memory set of the mints flagged on_token_list, so the N1 hygiene check
+// is a hash lookup instead of a query per update.
+//
+// A background thread holds its own Postgres connection, LISTENs on the
+// token_list_changed channel (fed by row-level triggers on tokens)
+// and reloads the set whenever it is notified, after a reconnect, and every
+// token_list_refresh_seconds as a fallback. Readers always see a complete
+// snapshot; a reload swaps it in atomically.
+class TokenListIndex {
+public:
+    explicit TokenListIndex(const Config& config);
+    ~TokenListIndex();
+    
+    void start();
+    void stop();
+    
+    bool contains(const std::string& mint) const;
+    
+    size_t size() const;
+    
+    // Non-copyable
+    TokenListIndex(const TokenListIndex&) = delete;
+    TokenListIndex& operator=(const TokenListIndex&) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
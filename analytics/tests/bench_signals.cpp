@@ -0,0 +1,177 @@
+// Parity check and benchmark for SignalCalculator::calculate_batch.
+//
+// Scores 100k randomized market updates through the per-update signal
+// functions and through the batch kernel, fails unless every signal is
+// bit-for-bit equal, then reports how long each path takes.
+
+#include "signals.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kUpdates = 100000;
+constexpr int kRuns = 5;
+
+struct Sample {
+    MarketUpdate update;
+    std::optional<TokenMetadata> metadata;
+    PriceIndicators indicators;
+};
+
+// Values land on, just below and just above the curve breakpoints often
+// enough to exercise the steps and clamps, not only the interiors
+double pick(std::mt19937_64& rng, const std::vector<double>& breakpoints, double lo, double hi) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double roll = unit(rng);
+    if (roll < 0.2) {
+        double point = breakpoints[rng() % breakpoints.size()];
+        double nudge = roll < 0.07 ? 0.0 : (roll < 0.14 ? -1e-9 : 1e-9);
+        return point + nudge * std::max(1.0, std::abs(point));
+    }
+    return lo + (hi - lo) * unit(rng);
+}
+
+std::vector<Sample> make_samples(const Config& config, size_t count) {
+    std::mt19937_64 rng(20241016);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    
+    std::vector<Sample> samples(count);
+    for (auto& sample : samples) {
+        auto& u = sample.update;
+        u.mint_base = "mint";
+        u.liq_usd = pick(rng, {0.0, config.min_liquidity_headsup, config.min_liquidity_actionable,
+                               500000.0, 1000000.0, 2000000.0}, -1000.0, 3000000.0);
+        u.vol24h_usd = pick(rng, {0.0, config.min_volume_headsup, config.min_volume_actionable,
+                                  2000000.0, 5000000.0, 10000000.0}, -1000.0, 12000000.0);
+        u.spread_pct = pick(rng, {0.0, config.max_spread_pct}, -0.1, 2.0 * config.max_spread_pct);
+        u.impact_1pct_pct = pick(rng, {0.0, config.max_impact_pct}, -0.1, 2.0 * config.max_impact_pct);
+        u.age_hours = pick(rng, {0.0, 720.0}, 0.0, 2000.0);
+        u.route = RouteInfo{unit(rng) < 0.9, static_cast<int>(rng() % 6),
+                            pick(rng, {0.0, config.max_route_deviation}, 0.0, 2.0 * config.max_route_deviation)};
+        
+        if (unit(rng) < 0.8) {
+            double open = 1.0 + unit(rng);
+            double move = pick(rng, {-10.0, -5.0, 0.0, config.min_m1h_pct, 6.0, config.max_m1h_pct}, -15.0, 20.0);
+            u.bars["5m"] = OHLCVBar{open, open * 1.05, open * 0.95, open * (1.0 + move / 100.0), 1000.0};
+        }
+        if (unit(rng) < 0.8) {
+            double open = 1.0 + unit(rng);
+            double move = pick(rng, {-30.0, -10.0, 0.0, config.min_m24h_pct, 20.0, config.max_m24h_pct}, -40.0, 60.0);
+            double range = pick(rng, {0.0, 5.0, 10.0, 20.0}, 0.0, 30.0);
+            double low = open * 0.9;
+            u.bars["15m"] = OHLCVBar{open, low * (1.0 + range / 100.0), low, open * (1.0 + move / 100.0), 1000.0};
+        }
+        
+        auto& ind = sample.indicators;
+        ind.h1.ready = unit(rng) < 0.5;
+        ind.h1.return_pct = pick(rng, {-10.0, -5.0, 0.0, config.min_m1h_pct, 6.0, config.max_m1h_pct}, -15.0, 20.0);
+        ind.h1.range_pct = pick(rng, {0.0, 5.0, 10.0, 20.0}, 0.0, 30.0);
+        ind.h24.ready = unit(rng) < 0.3;
+        ind.h24.return_pct = pick(rng, {-30.0, -10.0, 0.0, config.min_m24h_pct, 20.0, config.max_m24h_pct}, -40.0, 60.0);
+        ind.has_relative = unit(rng) < 0.5;
+        ind.relative_1h_pct = pick(rng, {-10.0, 0.0, 10.0}, -20.0, 20.0);
+        
+        if (unit(rng) < 0.7) {
+            TokenMetadata metadata{};
+            metadata.mint = u.mint_base;
+            metadata.top_holder_pct = pick(rng, {0.0, 100.0}, 0.0, 100.0);
+            metadata.risky_authorities = unit(rng) < 0.2;
+            sample.metadata = metadata;
+        }
+    }
+    return samples;
+}
+
+// The per-update path, as calculate_signals runs it (minus N1 and the reasons)
+void score_one_by_one(SignalCalculator& calculator, const std::vector<Sample>& samples, SignalBatchResult& out) {
+    out.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const auto& s = samples[i];
+        out.s1_liquidity[i] = calculator.calculate_s1_liquidity(s.update);
+        out.s2_volume[i] = calculator.calculate_s2_volume(s.update);
+        out.s3_momentum_1h[i] = calculator.calculate_s3_momentum_1h(s.update, s.indicators);
+        out.s4_momentum_24h[i] = calculator.calculate_s4_momentum_24h(s.update, s.indicators);
+        out.s5_volatility[i] = calculator.calculate_s5_volatility(s.update, s.indicators);
+        out.s6_price_discovery[i] = calculator.calculate_s6_price_discovery(s.update, s.indicators);
+        out.s7_rug_risk[i] = calculator.calculate_s7_rug_risk(s.update, s.metadata);
+        out.s8_tradability[i] = calculator.calculate_s8_tradability(s.update);
+        out.s9_relative_strength[i] = calculator.calculate_s9_relative_strength(s.indicators);
+        out.s10_route_quality[i] = calculator.calculate_s10_route_quality(s.update);
+        out.data_quality[i] = calculator.calculate_data_quality(s.update);
+    }
+}
+
+size_t count_mismatches(const char* name, const std::vector<double>& scalar, const std::vector<double>& batch) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < scalar.size(); ++i) {
+        if (std::memcmp(&scalar[i], &batch[i], sizeof(double)) != 0) {
+            if (mismatches == 0) {
+                std::printf("%s differs at %zu: scalar %.17g, batch %.17g\n", name, i, scalar[i], batch[i]);
+            }
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+template <typename F>
+double median_ms(F&& run) {
+    std::vector<double> times;
+    for (int i = 0; i < kRuns; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+} // namespace
+
+int main() {
+    Config config;
+    SignalCalculator calculator(config);
+    auto samples = make_samples(config, kUpdates);
+    
+    SignalBatch batch;
+    batch.reserve(samples.size());
+    for (const auto& s : samples) {
+        batch.push_back(s.update, s.metadata, s.indicators);
+    }
+    
+    SignalBatchResult scalar;
+    SignalBatchResult batched;
+    score_one_by_one(calculator, samples, scalar);
+    calculator.calculate_batch(batch, batched);
+    
+    size_t mismatches = 0;
+    mismatches += count_mismatches("s1_liquidity", scalar.s1_liquidity, batched.s1_liquidity);
+    mismatches += count_mismatches("s2_volume", scalar.s2_volume, batched.s2_volume);
+    mismatches += count_mismatches("s3_momentum_1h", scalar.s3_momentum_1h, batched.s3_momentum_1h);
+    mismatches += count_mismatches("s4_momentum_24h", scalar.s4_momentum_24h, batched.s4_momentum_24h);
+    mismatches += count_mismatches("s5_volatility", scalar.s5_volatility, batched.s5_volatility);
+    mismatches += count_mismatches("s6_price_discovery", scalar.s6_price_discovery, batched.s6_price_discovery);
+    mismatches += count_mismatches("s7_rug_risk", scalar.s7_rug_risk, batched.s7_rug_risk);
+    mismatches += count_mismatches("s8_tradability", scalar.s8_tradability, batched.s8_tradability);
+    mismatches += count_mismatches("s9_relative_strength", scalar.s9_relative_strength, batched.s9_relative_strength);
+    mismatches += count_mismatches("s10_route_quality", scalar.s10_route_quality, batched.s10_route_quality);
+    mismatches += count_mismatches("data_quality", scalar.data_quality, batched.data_quality);
+    
+    if (mismatches > 0) {
+        std::printf("FAILED: %zu signal values differ between the scalar and batch paths\n", mismatches);
+        return 1;
+    }
+    std::printf("%zu updates: scalar and batch signals are bit-for-bit equal\n", samples.size());
+    
+    double scalar_ms = median_ms([&] { score_one_by_one(calculator, samples, scalar); });
+    double batch_ms = median_ms([&] { calculator.calculate_batch(batch, batched); });
+    std::printf("per-update path: %.2f ms, batch kernel: %.2f ms (median of %d runs)\n",
+                scalar_ms, batch_ms, kRuns);
+    return 0;
+}
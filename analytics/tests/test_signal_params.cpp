@@ -0,0 +1,137 @@
+// Signal curves built from Config: settings with thresholds on the far side
+// of a fixed breakpoint still load, and out-of-order settings are refused
+// with an error naming the environment variables.
+
+#include "signals.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+using EnvVars = std::initializer_list<std::pair<const char*, const char*>>;
+
+// Config as load_from_env reads it with `vars` set
+Config load_with(EnvVars vars) {
+    for (const auto& [name, value] : vars) {
+        setenv(name, value, 1);
+    }
+    Config config;
+    try {
+        config.load_from_env();
+    } catch (...) {
+        for (const auto& [name, value] : vars) {
+            unsetenv(name);
+        }
+        throw;
+    }
+    for (const auto& [name, value] : vars) {
+        unsetenv(name);
+    }
+    return config;
+}
+
+// The error load_from_env raises with `vars` set, empty if it loads
+std::string load_error(EnvVars vars) {
+    try {
+        load_with(vars);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return "";
+}
+
+template <typename Curve>
+bool non_decreasing(const Curve& curve, double from, double to) {
+    double previous = curve(from);
+    for (int i = 1; i <= 1000; ++i) {
+        double value = curve(from + (to - from) * i / 1000.0);
+        if (value < previous) {
+            return false;
+        }
+        previous = value;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    {
+        auto params = SignalParams::from_config(Config{});
+        check(params.liquidity(150000.0) == 0.5, "default liquidity curve is 0.5 at MIN_LIQUIDITY_ACTIONABLE");
+        check(params.liquidity(500000.0) == 0.8, "default liquidity curve is 0.8 at 500k");
+        check(params.momentum_1h(6.0) == 0.9, "default 1h momentum curve is 0.9 at +6%");
+        check(params.momentum_1h(12.0) == 1.0, "default 1h momentum curve is 1.0 at MAX_M1H_PCT");
+    }
+    
+    {
+        Config config = load_with({{"MAX_M1H_PCT", "5"}});
+        check(config.max_m1h_pct == 5.0, "MAX_M1H_PCT is read from the environment");
+        auto params = SignalParams::from_config(config);
+        check(params.momentum_1h(1.0) == 0.7, "MAX_M1H_PCT=5 keeps 0.7 at MIN_M1H_PCT");
+        check(params.momentum_1h(5.0) == 1.0, "MAX_M1H_PCT=5 reaches 1.0 at +5%");
+        check(non_decreasing(params.momentum_1h, -20.0, 20.0), "MAX_M1H_PCT=5 curve is non-decreasing");
+        SignalCalculator calculator(config);
+    }
+    
+    {
+        Config config = load_with({{"MIN_LIQUIDITY_ACTIONABLE", "600000"}});
+        auto params = SignalParams::from_config(config);
+        check(params.liquidity(1000000.0) == 0.9, "MIN_LIQUIDITY_ACTIONABLE=600000 keeps 0.9 at 1M");
+        check(non_decreasing(params.liquidity, 0.0, 3000000.0),
+              "MIN_LIQUIDITY_ACTIONABLE=600000 curve is non-decreasing");
+        SignalCalculator calculator(config);
+    }
+    
+    {
+        Config config = load_with({{"MIN_M24H_PCT", "25"}, {"MIN_M1H_PCT", "-2"}});
+        auto params = SignalParams::from_config(config);
+        check(params.momentum_24h(25.0) == 0.9, "MIN_M24H_PCT=25 steps past the fixed +20% point to 0.9");
+        check(non_decreasing(params.momentum_24h, -40.0, 80.0), "MIN_M24H_PCT=25 curve is non-decreasing");
+        check(non_decreasing(params.momentum_1h, -20.0, 20.0), "MIN_M1H_PCT=-2 curve is non-decreasing");
+    }
+    
+    {
+        auto error = load_error({{"MIN_M1H_PCT", "8"}, {"MAX_M1H_PCT", "5"}});
+        check(error.find("MIN_M1H_PCT") != std::string::npos && error.find("MAX_M1H_PCT") != std::string::npos,
+              "MIN_M1H_PCT above MAX_M1H_PCT is refused by name");
+    }
+    
+    {
+        auto error = load_error({{"MIN_LIQUIDITY_HEADSUP", "200000"}});
+        check(error.find("MIN_LIQUIDITY_HEADSUP") != std::string::npos &&
+              error.find("MIN_LIQUIDITY_ACTIONABLE") != std::string::npos,
+              "MIN_LIQUIDITY_HEADSUP above MIN_LIQUIDITY_ACTIONABLE is refused by name");
+    }
+    
+    {
+        Config config;
+        config.max_route_hops = 0;
+        bool refused = false;
+        try {
+            SignalCalculator calculator(config);
+        } catch (const std::invalid_argument& e) {
+            refused = std::string(e.what()).find("MAX_ROUTE_HOPS") != std::string::npos;
+        }
+        check(refused, "SignalCalculator refuses MAX_ROUTE_HOPS=0 by name");
+    }
+    
+    if (failures > 0) {
+        return 1;
+    }
+    std::printf("signal curve config checks passed\n");
+    return 0;
+}
@@ -0,0 +1,328 @@
+#include "account_subscriber.hpp"
+#include "util.hpp"
+#include <ixwebsocket/IXNetSystem.h>
+#include <ixwebsocket/IXWebSocket.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+class AccountSubscriber::Impl {
+public:
+    Impl(const Config& config, ReserveCallback on_reserve)
+        : config_(config), on_reserve_(std::move(on_reserve)) {
+        // Explicit WebSocket endpoints win; otherwise derive them from the RPC list
+        if (!config_.solana_ws_urls.empty()) {
+            ws_urls_ = config_.solana_ws_urls;
+        } else {
+            for (const auto& url : config_.solana_rpc_urls) {
+                ws_urls_.push_back(to_ws_url(url));
+            }
+        }
+        
+        ix::initNetSystem();
+        
+        ws_.disableAutomaticReconnection();
+        ws_.setPingInterval(30);
+        ws_.setOnMessageCallback([this](const ix::WebSocketMessagePtr& msg) {
+            on_message(msg);
+        });
+    }
+    
+    ~Impl() {
+        stop();
+        ix::uninitNetSystem();
+    }
+    
+    void start() {
+        if (ws_urls_.empty()) {
+            spdlog::warn("No Solana WebSocket endpoint configured, account subscriptions disabled");
+            return;
+        }
+        
+        ws_.setUrl(ws_urls_[url_index_]);
+        ws_.enableAutomaticReconnection();
+        ws_.setMinWaitBetweenReconnectionRetries(
+            static_cast<uint32_t>(config_.base_backoff_seconds * 1000));
+        ws_.setMaxWaitBetweenReconnectionRetries(
+            static_cast<uint32_t>(config_.max_backoff_seconds * 1000));
+        ws_.start();
+        
+        spdlog::info("Account subscriber connecting to {}", ws_urls_[url_index_]);
+    }
+    
+    void stop() {
+        ws_.disableAutomaticReconnection();
+        ws_.stop();
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_subs_.clear();
+        sub_to_vault_.clear();
+        pending_.clear();
+        pending_vaults_.clear();
+    }
+    
+    void refresh_subscriptions(const std::vector<PoolInfo>& pools) {
+        // Pools arrive ranked; keep the first top-N that expose their vault accounts
+        size_t top_n = static_cast<size_t>(config_.account_subscribe_top_n);
+        std::unordered_map<std::string, VaultRef> wanted;
+        wanted.reserve(std::min(pools.size(), top_n) * 2);
+        for (const auto& pool : pools) {
+            if (wanted.size() >= top_n * 2) break;
+            if (pool.vault_a.empty() || pool.vault_b.empty()) continue;
+            
+            wanted[pool.vault_a] = {pool.pool_id, true};
+            wanted[pool.vault_b] = {pool.pool_id, false};
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Drop vaults that fell out of the top-N
+        for (auto it = active_subs_.begin(); it != active_subs_.end();) {
+            if (wanted.find(it->first) == wanted.end()) {
+                send_unsubscribe(it->second);
+                sub_to_vault_.erase(it->second);
+                it = active_subs_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        
+        // Subscribe to newly wanted vaults
+        for (const auto& [vault, ref] : wanted) {
+            if (active_subs_.find(vault) == active_subs_.end() && !is_pending(vault)) {
+                send_subscribe(vault);
+            }
+        }
+        
+        wanted_ = std::move(wanted);
+        
+        spdlog::debug("Account subscriber tracking {} vaults ({} active)", wanted_.size(), active_subs_.size());
+    }
+    
+    size_t subscription_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return active_subs_.size();
+    }
+    
+    bool is_connected() const {
+        return connected_;
+    }
+
+private:
+    struct VaultRef {
+        std::string pool_id;
+        bool is_token_a = true;
+    };
+    
+    void on_message(const ix::WebSocketMessagePtr& msg) {
+        switch (msg->type) {
+            case ix::WebSocketMessageType::Open:
+                on_open();
+                break;
+            case ix::WebSocketMessageType::Close:
+                on_close();
+                break;
+            case ix::WebSocketMessageType::Error:
+                on_error(msg->errorInfo.reason);
+                break;
+            case ix::WebSocketMessageType::Message:
+                on_text(msg->str);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    void on_open() {
+        connected_ = true;
+        spdlog::info("Account subscriber connected to {}", ws_urls_[url_index_]);
+        
+        // Subscription ids don't survive a reconnect, so resubscribe everything
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_subs_.clear();
+        sub_to_vault_.clear();
+        pending_.clear();
+        pending_vaults_.clear();
+        for (const auto& [vault, ref] : wanted_) {
+            send_subscribe(vault);
+        }
+    }
+    
+    void on_close() {
+        connected_ = false;
+        spdlog::warn("Account subscriber connection closed");
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_subs_.clear();
+        sub_to_vault_.clear();
+        pending_.clear();
+        pending_vaults_.clear();
+    }
+    
+    void on_error(const std::string& reason) {
+        connected_ = false;
+        spdlog::error("Account subscriber error on {}: {}", ws_urls_[url_index_], reason);
+        
+        // Rotate to the next endpoint for the next reconnection attempt
+        if (ws_urls_.size() > 1) {
+            url_index_ = (url_index_ + 1) % ws_urls_.size();
+            ws_.setUrl(ws_urls_[url_index_]);
+        }
+    }
+    
+    void on_text(const std::string& text) {
+        try {
+            auto json_msg = nlohmann::json::parse(text);
+            
+            // Subscription confirmation: {"id": <req>, "result": <subscription id>}
+            if (json_msg.contains("id") && json_msg.contains("result") && json_msg["result"].is_number_unsigned()) {
+                handle_subscribe_ack(json_msg["id"].get<uint64_t>(), json_msg["result"].get<uint64_t>());
+                return;
+            }
+            
+            if (json_msg.contains("error")) {
+                spdlog::warn("Account subscriber RPC error: {}", json_msg["error"].dump());
+                return;
+            }
+            
+            if (json_msg.value("method", "") == "accountNotification") {
+                handle_notification(json_msg["params"]);
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("Error parsing account notification: {}", e.what());
+        }
+    }
+    
+    void handle_subscribe_ack(uint64_t request_id, uint64_t subscription_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = pending_.find(request_id);
+        if (it == pending_.end()) {
+            return; // Unsubscribe ack or stale request
+        }
+        
+        std::string vault = std::move(it->second);
+        pending_.erase(it);
+        pending_vaults_.erase(vault);
+        
+        // The vault may have dropped out of the top-N while the request was in flight
+        if (wanted_.find(vault) == wanted_.end()) {
+            send_unsubscribe(subscription_id);
+            return;
+        }
+        
+        active_subs_[vault] = subscription_id;
+        sub_to_vault_[subscription_id] = vault;
+    }
+    
+    void handle_notification(const nlohmann::json& params) {
+        VaultRef ref;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto sub_it = sub_to_vault_.find(params.at("subscription").get<uint64_t>());
+            if (sub_it == sub_to_vault_.end()) {
+                return;
+            }
+            auto ref_it = wanted_.find(sub_it->second);
+            if (ref_it == wanted_.end()) {
+                return;
+            }
+            ref = ref_it->second;
+        }
+        
+        // jsonParsed SPL token account: value.data.parsed.info.tokenAmount
+        const auto& token_amount = params.at("result").at("value").at("data")
+                                         .at("parsed").at("info").at("tokenAmount");
+        
+        double reserve = 0.0;
+        if (token_amount.contains("uiAmountString")) {
+            reserve = util::safe_parse_double(token_amount["uiAmountString"].get<std::string>());
+        } else if (token_amount.contains("uiAmount") && token_amount["uiAmount"].is_number()) {
+            reserve = token_amount["uiAmount"].get<double>();
+        }
+        
+        if (on_reserve_) {
+            on_reserve_(ref.pool_id, ref.is_token_a, reserve);
+        }
+    }
+    
+    // Must be called with mutex_ held
+    void send_subscribe(const std::string& vault) {
+        if (!connected_) {
+            return; // on_open() resubscribes everything in wanted_
+        }
+        
+        uint64_t request_id = next_request_id_++;
+        nlohmann::json request = {
+            {"jsonrpc", "2.0"},
+            {"id", request_id},
+            {"method", "accountSubscribe"},
+            {"params", {vault, {{"encoding", "jsonParsed"}, {"commitment", "confirmed"}}}}
+        };
+        
+        pending_[request_id] = vault;
+        pending_vaults_.insert(vault);
+        ws_.send(request.dump());
+    }
+    
+    // Must be called with mutex_ held
+    void send_unsubscribe(uint64_t subscription_id) {
+        if (!connected_) {
+            return;
+        }
+        
+        nlohmann::json request = {
+            {"jsonrpc", "2.0"},
+            {"id", next_request_id_++},
+            {"method", "accountUnsubscribe"},
+            {"params", {subscription_id}}
+        };
+        
+        ws_.send(request.dump());
+    }
+    
+    // Must be called with mutex_ held
+    bool is_pending(const std::string& vault) const {
+        return pending_vaults_.count(vault) > 0;
+    }
+    
+    static std::string to_ws_url(const std::string& rpc_url) {
+        if (util::starts_with(rpc_url, "https://")) {
+            return "wss://" + rpc_url.substr(8);
+        }
+        if (util::starts_with(rpc_url, "http://")) {
+            return "ws://" + rpc_url.substr(7);
+        }
+        return rpc_url;
+    }
+    
+    const Config& config_;
+    ReserveCallback on_reserve_;
+    std::vector<std::string> ws_urls_;
+    size_t url_index_ = 0;
+    
+    ix::WebSocket ws_;
+    std::atomic<bool> connected_{false};
+    
+    mutable std::mutex mutex_;
+    uint64_t next_request_id_ = 1;
+    std::unordered_map<std::string, VaultRef> wanted_;           // vault -> pool side
+    std::unordered_map<std::string, uint64_t> active_subs_;      // vault -> subscription id
+    std::unordered_map<uint64_t, std::string> sub_to_vault_;     // subscription id -> vault
+    std::unordered_map<uint64_t, std::string> pending_;          // request id -> vault
+    std::unordered_set<std::string> pending_vaults_;
+};
+
+// --- PIMPL forward declarations ---
+AccountSubscriber::AccountSubscriber(const Config& config, ReserveCallback on_reserve)
+    : pImpl_(std::make_unique<Impl>(config, std::move(on_reserve))) {}
+AccountSubscriber::~AccountSubscriber() = default;
+void AccountSubscriber::start() { pImpl_->start(); }
+void AccountSubscriber::stop() { pImpl_->stop(); }
+void AccountSubscriber::refresh_subscriptions(const std::vector<PoolInfo>& pools) { pImpl_->refresh_subscriptions(pools); }
+size_t AccountSubscriber::subscription_count() const { return pImpl_->subscription_count(); }
+bool AccountSubscriber::is_connected() const { return pImpl_->is_connected(); }
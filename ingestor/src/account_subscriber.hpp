@@ -0,0 +1,42 @@
+#pragma once
+
+#include "config.hpp"
+#include "types.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Streams SPL token vault balances for the most liquid pools over the Solana
+// WebSocket API (accountSubscribe), so reserve changes are seen as soon as they
+// land on-chain instead of on the next REST poll.
+class AccountSubscriber {
+public:
+    // Called with the vault's pool id, which side of the pool it backs, and the
+    // new token balance (UI units).
+    using ReserveCallback = std::function<void(const std::string& pool_id, bool is_token_a, double reserve)>;
+    
+    AccountSubscriber(const Config& config, ReserveCallback on_reserve);
+    ~AccountSubscriber();
+    
+    // Connect to the first configured WebSocket endpoint and start streaming
+    void start();
+    
+    // Unsubscribe everything and close the connection
+    void stop();
+    
+    // Re-target subscriptions at the first top-N pools with vault accounts,
+    // taken in the given order (best first, e.g. PoolCache::get_top_pools_by_tvl).
+    // Vaults no longer in the set are unsubscribed, new ones are subscribed.
+    void refresh_subscriptions(const std::vector<PoolInfo>& pools);
+    
+    // Number of vault accounts currently subscribed
+    size_t subscription_count() const;
+    
+    // Whether the WebSocket connection is currently open
+    bool is_connected() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
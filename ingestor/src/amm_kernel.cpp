@@ -0,0 +1,242 @@
+#include "amm_kernel.hpp"
+#include "simd.hpp"
+#include <algorithm>
+
+namespace {
+
+using namespace simd;
+
+// Newton steps for the StableSwap invariant; converges well within this for
+// any realistic amplification and balance ratio, and a fixed count keeps the
+// loop branch-free across lanes
+constexpr int kStableSwapIterations = 16;
+
+constexpr double kDefaultStableAmp = 100.0;
+
+// --- Constant product ------------------------------------------------------
+//
+// Selling dx (after fee) into x*y=k moves the spot price y/x by
+// 1 - (x / (x + dx))^2.
+
+inline vd cp_impact(vd x, vd dx, vd one_minus_fee, vd one, vd hundred) {
+    vd ratio = vdiv(x, vadd(x, vmul(dx, one_minus_fee)));
+    return vmul(hundred, vsub(one, vmul(ratio, ratio)));
+}
+
+// --- StableSwap (n = 2) ----------------------------------------------------
+//
+// Invariant: 4A(x + y) + D = 4AD + D^3 / (4xy)
+
+struct StableConsts {
+    vd ann;         // 4A
+    vd ann_minus_1;
+    vd inv_ann;     // 1 / 4A
+    vd four;
+    vd two;
+    vd three;
+    vd half;
+    vd one;
+    vd hundred;
+};
+
+inline vd stable_d(vd x, vd y, const StableConsts& c) {
+    vd s = vadd(x, y);
+    vd d = s;
+    vd four_xy = vmul(c.four, vmul(x, y));
+    for (int i = 0; i < kStableSwapIterations; ++i) {
+        vd d_p = vdiv(vmul(d, vmul(d, d)), four_xy);
+        vd num = vmul(vadd(vmul(c.ann, s), vmul(c.two, d_p)), d);
+        vd den = vadd(vmul(c.ann_minus_1, d), vmul(c.three, d_p));
+        d = vdiv(num, den);
+    }
+    return d;
+}
+
+// Solve the invariant for y given x: y^2 + (x + D/4A - D) y = D^3 / (16 A x)
+inline vd stable_y(vd x, vd d, vd d3, const StableConsts& c) {
+    vd b = vsub(vadd(x, vmul(d, c.inv_ann)), d);
+    vd cc = vdiv(vmul(d3, c.inv_ann), vmul(c.four, x));
+    vd disc = vadd(vmul(b, b), vmul(c.four, cc));
+    return vmul(c.half, vadd(vsub(vset(0.0), b), vsqrt(vmax(disc, vset(0.0)))));
+}
+
+// Marginal price -dy/dx = F_x / F_y of the invariant at (x, y)
+inline vd stable_price(vd x, vd y, vd d3, const StableConsts& c) {
+    vd fx = vadd(c.ann, vdiv(d3, vmul(c.four, vmul(vmul(x, x), y))));
+    vd fy = vadd(c.ann, vdiv(d3, vmul(c.four, vmul(x, vmul(y, y)))));
+    return vdiv(fx, fy);
+}
+
+inline vd stable_impact(vd x, vd dx, vd one_minus_fee, vd d, vd d3, vd p0, const StableConsts& c) {
+    vd x1 = vadd(x, vmul(dx, one_minus_fee));
+    vd y1 = stable_y(x1, d, d3, c);
+    vd p1 = stable_price(x1, y1, d3, c);
+    return vmul(c.hundred, vsub(c.one, vdiv(p1, p0)));
+}
+
+} // namespace
+
+namespace amm {
+
+void PoolBatch::reserve(size_t n) {
+    reserve_in.reserve(n);
+    reserve_out.reserve(n);
+    fee_rate.reserve(n);
+    in_per_usd.reserve(n);
+}
+
+void PoolBatch::add(double in, double out, double fee, double per_usd) {
+    reserve_in.push_back(in);
+    reserve_out.push_back(out);
+    fee_rate.push_back(fee);
+    in_per_usd.push_back(per_usd);
+}
+
+void ImpactBatch::resize(size_t n) {
+    pct_1pct.resize(n);
+    usd_1k.resize(n);
+    usd_10k.resize(n);
+}
+
+void constant_product_impact(const PoolBatch& pools, ImpactBatch& out) {
+    size_t n = pools.size();
+    out.resize(n);
+    
+    const vd one = vset(1.0);
+    const vd hundred = vset(100.0);
+    const vd pct = vset(0.01);
+    const vd usd_1k = vset(1000.0);
+    const vd usd_10k = vset(10000.0);
+    
+    // Pad the tail into a scratch block so every pool goes through the same vector path
+    size_t full = n - n % kLanes;
+    auto block = [&](const double* x_p, const double* fee_p, const double* per_usd_p,
+                     double* o1, double* o2, double* o3) {
+        vd x = vload(x_p);
+        vd one_minus_fee = vsub(one, vload(fee_p));
+        vd per_usd = vload(per_usd_p);
+        vstore(o1, cp_impact(x, vmul(x, pct), one_minus_fee, one, hundred));
+        vstore(o2, cp_impact(x, vmul(per_usd, usd_1k), one_minus_fee, one, hundred));
+        vstore(o3, cp_impact(x, vmul(per_usd, usd_10k), one_minus_fee, one, hundred));
+    };
+    
+    for (size_t i = 0; i < full; i += kLanes) {
+        block(&pools.reserve_in[i], &pools.fee_rate[i], &pools.in_per_usd[i],
+              &out.pct_1pct[i], &out.usd_1k[i], &out.usd_10k[i]);
+    }
+    
+    if (full < n) {
+        double x[kLanes], fee[kLanes], per_usd[kLanes], o1[kLanes], o2[kLanes], o3[kLanes];
+        std::fill(x, x + kLanes, 1.0);
+        std::fill(fee, fee + kLanes, 0.0);
+        std::fill(per_usd, per_usd + kLanes, 0.0);
+        std::copy(pools.reserve_in.begin() + full, pools.reserve_in.end(), x);
+        std::copy(pools.fee_rate.begin() + full, pools.fee_rate.end(), fee);
+        std::copy(pools.in_per_usd.begin() + full, pools.in_per_usd.end(), per_usd);
+        block(x, fee, per_usd, o1, o2, o3);
+        std::copy(o1, o1 + (n - full), out.pct_1pct.begin() + full);
+        std::copy(o2, o2 + (n - full), out.usd_1k.begin() + full);
+        std::copy(o3, o3 + (n - full), out.usd_10k.begin() + full);
+    }
+}
+
+void stableswap_impact(const PoolBatch& pools, double amp, ImpactBatch& out) {
+    size_t n = pools.size();
+    out.resize(n);
+    
+    StableConsts c;
+    c.ann = vset(4.0 * amp);
+    c.ann_minus_1 = vset(4.0 * amp - 1.0);
+    c.inv_ann = vset(1.0 / (4.0 * amp));
+    c.four = vset(4.0);
+    c.two = vset(2.0);
+    c.three = vset(3.0);
+    c.half = vset(0.5);
+    c.one = vset(1.0);
+    c.hundred = vset(100.0);
+    
+    const vd pct = vset(0.01);
+    const vd usd_1k = vset(1000.0);
+    const vd usd_10k = vset(10000.0);
+    
+    size_t full = n - n % kLanes;
+    auto block = [&](const double* x_p, const double* y_p, const double* fee_p, const double* per_usd_p,
+                     double* o1, double* o2, double* o3) {
+        vd x = vload(x_p);
+        vd y = vload(y_p);
+        vd one_minus_fee = vsub(c.one, vload(fee_p));
+        vd per_usd = vload(per_usd_p);
+        
+        vd d = stable_d(x, y, c);
+        vd d3 = vmul(d, vmul(d, d));
+        vd p0 = stable_price(x, y, d3, c);
+        
+        vstore(o1, stable_impact(x, vmul(x, pct), one_minus_fee, d, d3, p0, c));
+        vstore(o2, stable_impact(x, vmul(per_usd, usd_1k), one_minus_fee, d, d3, p0, c));
+        vstore(o3, stable_impact(x, vmul(per_usd, usd_10k), one_minus_fee, d, d3, p0, c));
+    };
+    
+    for (size_t i = 0; i < full; i += kLanes) {
+        block(&pools.reserve_in[i], &pools.reserve_out[i], &pools.fee_rate[i], &pools.in_per_usd[i],
+              &out.pct_1pct[i], &out.usd_1k[i], &out.usd_10k[i]);
+    }
+    
+    if (full < n) {
+        double x[kLanes], y[kLanes], fee[kLanes], per_usd[kLanes], o1[kLanes], o2[kLanes], o3[kLanes];
+        std::fill(x, x + kLanes, 1.0);
+        std::fill(y, y + kLanes, 1.0);
+        std::fill(fee, fee + kLanes, 0.0);
+        std::fill(per_usd, per_usd + kLanes, 0.0);
+        std::copy(pools.reserve_in.begin() + full, pools.reserve_in.end(), x);
+        std::copy(pools.reserve_out.begin() + full, pools.reserve_out.end(), y);
+        std::copy(pools.fee_rate.begin() + full, pools.fee_rate.end(), fee);
+        std::copy(pools.in_per_usd.begin() + full, pools.in_per_usd.end(), per_usd);
+        block(x, y, fee, per_usd, o1, o2, o3);
+        std::copy(o1, o1 + (n - full), out.pct_1pct.begin() + full);
+        std::copy(o2, o2 + (n - full), out.usd_1k.begin() + full);
+        std::copy(o3, o3 + (n - full), out.usd_10k.begin() + full);
+    }
+}
+
+void compute_pool_impacts(std::vector<PoolInfo>& pools) {
+    PoolBatch cp_batch;
+    PoolBatch stable_batch;
+    std::vector<size_t> cp_index;
+    std::vector<size_t> stable_index;
+    cp_batch.reserve(pools.size());
+    cp_index.reserve(pools.size());
+    
+    for (size_t i = 0; i < pools.size(); ++i) {
+        const auto& pool = pools[i];
+        if (pool.reserve_a <= 0 || pool.reserve_b <= 0) continue;
+        
+        // Half the TVL sits on each side of a balanced pool
+        double in_per_usd = pool.tvl_usd > 0 ? pool.reserve_a / (pool.tvl_usd / 2.0) : 0.0;
+        if (pool.pool_type == "stable") {
+            stable_batch.add(pool.reserve_a, pool.reserve_b, pool.fee_rate, in_per_usd);
+            stable_index.push_back(i);
+        } else {
+            cp_batch.add(pool.reserve_a, pool.reserve_b, pool.fee_rate, in_per_usd);
+            cp_index.push_back(i);
+        }
+    }
+    
+    ImpactBatch impacts;
+    constant_product_impact(cp_batch, impacts);
+    for (size_t k = 0; k < cp_index.size(); ++k) {
+        auto& pool = pools[cp_index[k]];
+        pool.price_impact_1pct = impacts.pct_1pct[k];
+        pool.price_impact_1k = impacts.usd_1k[k];
+        pool.price_impact_10k = impacts.usd_10k[k];
+    }
+    
+    stableswap_impact(stable_batch, kDefaultStableAmp, impacts);
+    for (size_t k = 0; k < stable_index.size(); ++k) {
+        auto& pool = pools[stable_index[k]];
+        pool.price_impact_1pct = impacts.pct_1pct[k];
+        pool.price_impact_1k = impacts.usd_1k[k];
+        pool.price_impact_10k = impacts.usd_10k[k];
+    }
+}
+
+} // namespace amm
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace amm {
+
+// Structure-of-arrays view of a set of pools, trading token A into token B.
+// Reserves are in UI units; in_per_usd converts a USD notional into token A
+// (0 when unknown, which yields zero impact for the USD-sized trades).
+struct PoolBatch {
+    std::vector<double> reserve_in;
+    std::vector<double> reserve_out;
+    std::vector<double> fee_rate;
+    std::vector<double> in_per_usd;
+    
+    void reserve(size_t n);
+    void add(double reserve_in, double reserve_out, double fee_rate, double in_per_usd);
+    size_t size() const { return reserve_in.size(); }
+};
+
+// Spot price move (percent) caused by selling token A into each pool
+struct ImpactBatch {
+    std::vector<double> pct_1pct;   // trade of 1% of reserve_in
+    std::vector<double> usd_1k;     // $1,000 trade
+    std::vector<double> usd_10k;    // $10,000 trade
+    
+    void resize(size_t n);
+};
+
+// Constant-product (x*y=k) pools
+void constant_product_impact(const PoolBatch& pools, ImpactBatch& out);
+
+// Two-coin StableSwap pools with amplification coefficient `amp`
+void stableswap_impact(const PoolBatch& pools, double amp, ImpactBatch& out);
+
+// Fill price_impact_1pct / _1k / _10k for every pool with usable reserves,
+// batching constant-product and stable pools separately
+void compute_pool_impacts(std::vector<PoolInfo>& pools);
+
+} // namespace amm
@@ -0,0 +1,329 @@
+#include "config.hpp"
+#include "db_manager.hpp"
+#include "dex_client.hpp"
+#include "http_archive.hpp"
+#include "ohlcv_aggregator.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// soul_backfill: rebuilds historical OHLCV bars offline and bulk-loads them.
+//
+//   soul_backfill [--format trades|bars|capture] [--workers N] [--intervals 5,15]
+//                 [--batch N] [--overwrite] <input>...
+//
+// trades  CSV rows "pool_id,timestamp,price[,volume]", aggregated into bars
+//         by the same OHLCVAggregator the ingestor runs
+// bars    CSV rows "pool_id,timestamp,interval_minutes,open,high,low,close[,volume]",
+//         loaded as they are
+// capture HTTP archive directories written with HTTP_ARCHIVE_MODE=capture; the
+//         recorded DEX responses are parsed by DexClient and every pool's spot
+//         price becomes a trade at the time the response was recorded
+//
+// Timestamps are epoch seconds, epoch milliseconds or ISO-8601. Pools are
+// spread over the workers by ID, and each worker aggregates its pools and
+// streams the bars to Postgres through its own COPY transactions.
+
+namespace {
+
+// Epoch values above this are taken to be milliseconds
+constexpr double kEpochMillisThreshold = 1e11;
+
+struct Options {
+    std::string format = "trades";
+    int workers = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> intervals{5, 15};
+    size_t batch_size = 100000;
+    bool overwrite = false;
+    std::vector<std::string> inputs;
+};
+
+struct Trade {
+    std::string pool_id;
+    std::chrono::system_clock::time_point timestamp;
+    double price;
+    double volume;
+};
+
+// Input owned by one worker; a pool always lands in the same partition
+struct Partition {
+    std::vector<Trade> trades;
+    std::vector<OHLCVBar> bars;
+};
+
+struct Totals {
+    std::atomic<size_t> input_rows{0};
+    std::atomic<size_t> bars_written{0};
+    std::atomic<size_t> failed_batches{0};
+};
+
+void print_usage() {
+    std::cerr << "usage: soul_backfill [--format trades|bars|capture] [--workers N] "
+                 "[--intervals 5,15] [--batch N] [--overwrite] <input>...\n";
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+        
+        if (arg == "--format") {
+            options.format = value();
+        } else if (arg == "--workers") {
+            options.workers = std::stoi(value());
+        } else if (arg == "--intervals") {
+            options.intervals.clear();
+            for (const auto& interval : util::split_string(value(), ',')) {
+                options.intervals.push_back(std::stoi(interval));
+            }
+        } else if (arg == "--batch") {
+            options.batch_size = std::stoul(value());
+        } else if (arg == "--overwrite") {
+            options.overwrite = true;
+        } else if (util::starts_with(arg, "--")) {
+            throw std::runtime_error("Unknown option " + arg);
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    
+    if (options.format != "trades" && options.format != "bars" && options.format != "capture") {
+        throw std::runtime_error("Format must be trades, bars or capture");
+    }
+    if (options.workers < 1 || options.batch_size < 1 || options.intervals.empty() ||
+        std::any_of(options.intervals.begin(), options.intervals.end(), [](int m) { return m < 1; })) {
+        throw std::runtime_error("Workers, batch size and intervals must be positive");
+    }
+    if (options.inputs.empty()) {
+        throw std::runtime_error("No input given");
+    }
+    
+    return options;
+}
+
+std::chrono::system_clock::time_point parse_timestamp(const std::string& field) {
+    if (field.find('T') != std::string::npos || field.find('-') != std::string::npos) {
+        return util::parse_iso8601(field);
+    }
+    
+    double epoch = std::stod(field);
+    auto ms = static_cast<int64_t>(epoch > kEpochMillisThreshold ? epoch : epoch * 1000.0);
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+}
+
+size_t partition_of(const std::string& pool_id, const std::vector<Partition>& partitions) {
+    return std::hash<std::string>{}(pool_id) % partitions.size();
+}
+
+void read_csv(const std::string& path, const Options& options, std::vector<Partition>& partitions,
+              Totals& totals) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    
+    size_t line_number = 0;
+    size_t skipped = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#' || util::starts_with(line, "pool_id")) continue;
+        
+        auto fields = util::split_string(line, ',');
+        try {
+            if (options.format == "bars") {
+                if (fields.size() < 7) throw std::runtime_error("expected at least 7 fields");
+                
+                OHLCVBar bar;
+                bar.pool_id = util::trim(fields[0]);
+                bar.timestamp = parse_timestamp(util::trim(fields[1]));
+                bar.interval_minutes = std::stoi(fields[2]);
+                bar.open = std::stod(fields[3]);
+                bar.high = std::stod(fields[4]);
+                bar.low = std::stod(fields[5]);
+                bar.close = std::stod(fields[6]);
+                bar.volume = fields.size() > 7 ? std::stod(fields[7]) : 0.0;
+                partitions[partition_of(bar.pool_id, partitions)].bars.push_back(std::move(bar));
+            } else {
+                if (fields.size() < 3) throw std::runtime_error("expected at least 3 fields");
+                
+                Trade trade;
+                trade.pool_id = util::trim(fields[0]);
+                trade.timestamp = parse_timestamp(util::trim(fields[1]));
+                trade.price = std::stod(fields[2]);
+                trade.volume = fields.size() > 3 ? std::stod(fields[3]) : 0.0;
+                partitions[partition_of(trade.pool_id, partitions)].trades.push_back(std::move(trade));
+            }
+            ++totals.input_rows;
+        } catch (const std::exception& e) {
+            if (++skipped <= 10) {
+                spdlog::warn("{}:{}: skipping row: {}", path, line_number, e.what());
+            }
+        }
+    }
+    
+    if (skipped > 0) {
+        spdlog::warn("{}: skipped {} malformed rows", path, skipped);
+    }
+}
+
+// Replays the recorded DEX responses without pacing until the archive runs dry
+void read_capture(const std::string& dir, const Config& base_config, std::vector<Partition>& partitions,
+                  Totals& totals) {
+    Config config = base_config;
+    config.http_archive_mode = "replay";
+    config.http_archive_dir = dir;
+    config.http_replay_speed = 0.0;
+    
+    HttpArchive archive(config);
+    DexClient dex_client(config, nullptr, &archive);
+    
+    while (true) {
+        auto pools = dex_client.fetch_pools();
+        if (pools.empty()) break;
+        
+        auto recorded_at = archive.last_replayed_at();
+        for (const auto& pool : pools) {
+            if (pool.price_token_a_in_b <= 0.0) continue;
+            
+            partitions[partition_of(pool.pool_id, partitions)].trades.push_back(
+                Trade{pool.pool_id, recorded_at, pool.price_token_a_in_b, 0.0});
+            ++totals.input_rows;
+        }
+    }
+}
+
+void copy_in_batches(DatabaseManager& db, const Options& options, std::vector<OHLCVBar>& bars,
+                     Totals& totals) {
+    for (size_t offset = 0; offset < bars.size(); offset += options.batch_size) {
+        auto end = bars.begin() + std::min(bars.size(), offset + options.batch_size);
+        std::vector<OHLCVBar> batch(std::make_move_iterator(bars.begin() + offset), std::make_move_iterator(end));
+        
+        if (db.copy_ohlcv_bars(batch, options.overwrite)) {
+            totals.bars_written += batch.size();
+        } else {
+            ++totals.failed_batches;
+        }
+    }
+    bars.clear();
+}
+
+void run_worker(DatabaseManager& db, const Options& options, Partition& partition, Totals& totals) {
+    std::vector<OHLCVBar> pending = std::move(partition.bars);
+    
+    auto& trades = partition.trades;
+    std::sort(trades.begin(), trades.end(), [](const Trade& a, const Trade& b) {
+        if (a.pool_id != b.pool_id) return a.pool_id < b.pool_id;
+        return a.timestamp < b.timestamp;
+    });
+    
+    // One pool at a time in time order: event-time completion then holds at
+    // most one open bar per interval, and the flush closes the pool's last ones
+    OHLCVAggregator aggregator(options.intervals, true);
+    for (size_t i = 0; i < trades.size(); ++i) {
+        const auto& trade = trades[i];
+        aggregator.add_price_point(trade.pool_id, trade.price, trade.volume, trade.timestamp);
+        
+        if (i + 1 == trades.size() || trades[i + 1].pool_id != trade.pool_id) {
+            for (auto& bar : aggregator.flush_all_bars()) {
+                pending.push_back(std::move(bar));
+            }
+            if (pending.size() >= options.batch_size) {
+                copy_in_batches(db, options, pending, totals);
+            }
+        }
+    }
+    trades.clear();
+    trades.shrink_to_fit();
+    
+    copy_in_batches(db, options, pending, totals);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        print_usage();
+        return 2;
+    }
+    
+    try {
+        Config config = Config::from_env();
+        config.validate();
+        
+        spdlog::set_level(spdlog::level::from_str(config.log_level));
+        spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [tid %t] %v");
+        
+        DatabaseManager db(config);
+        if (!db.initialize_schema()) {
+            throw std::runtime_error("Failed to initialize database schema");
+        }
+        
+        auto started = std::chrono::steady_clock::now();
+        Totals totals;
+        std::vector<Partition> partitions(static_cast<size_t>(options.workers));
+        
+        for (const auto& input : options.inputs) {
+            spdlog::info("Reading {} input {}", options.format, input);
+            if (options.format == "capture") {
+                read_capture(input, config, partitions, totals);
+            } else {
+                read_csv(input, options, partitions, totals);
+            }
+        }
+        
+        auto read_done = std::chrono::steady_clock::now();
+        spdlog::info("Read {} rows in {:.1f}s, loading with {} workers",
+                    totals.input_rows.load(),
+                    std::chrono::duration<double>(read_done - started).count(), options.workers);
+        
+        std::vector<std::thread> workers;
+        workers.reserve(partitions.size());
+        for (auto& partition : partitions) {
+            workers.emplace_back([&db, &options, &partition, &totals]() {
+                try {
+                    run_worker(db, options, partition, totals);
+                } catch (const std::exception& e) {
+                    spdlog::error("Backfill worker failed: {}", e.what());
+                    ++totals.failed_batches;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - read_done).count();
+        spdlog::info("Loaded {} bars in {:.1f}s ({:.0f} bars/min), {} failed batches",
+                    totals.bars_written.load(), load_seconds,
+                    load_seconds > 0.0 ? totals.bars_written.load() / load_seconds * 60.0 : 0.0,
+                    totals.failed_batches.load());
+        
+        return totals.failed_batches.load() == 0 ? 0 : 1;
+        
+    } catch (const std::exception& e) {
+        spdlog::critical("Backfill failed: {}", e.what());
+        return 1;
+    }
+}
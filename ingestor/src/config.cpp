@@ -3,6 +3,19 @@
 #include "util.hpp"
 #include <stdexcept>
 #include <spdlog/spdlog.h>
+#include <unistd.h>
+
+namespace {
+
+std::string default_instance_id() {
+    char hostname[256] = {};
+    if (gethostname(hostname, sizeof(hostname) - 1) != 0) {
+        return "ingestor-" + std::to_string(getpid());
+    }
+    return std::string(hostname) + "-" + std::to_string(getpid());
+}
+
+} // namespace
 
 Config Config::from_env() {
     Config config;
@@ -19,12 +32,27 @@ Config Config::from_env() {
     config.redis_port = std::stoi(get_env_var("REDIS_PORT", "6379"));
     config.redis_password = get_env_var("REDIS_PASSWORD");
     config.redis_stream = get_env_var("REDIS_STREAM", "soul.market.updates");
+    config.redis_watchlist_key = get_env_var("REDIS_WATCHLIST_KEY", "soul.watchlist");
+    
+    // Sharding
+    config.sharding_enabled = get_env_var("SHARDING_ENABLED", "false") == "true";
+    config.shard_count = std::stoi(get_env_var("SHARD_COUNT", "64"));
+    config.shard_lease_seconds = std::stoi(get_env_var("SHARD_LEASE_SECONDS", "15"));
+    config.instance_id = get_env_var("INSTANCE_ID", default_instance_id());
+    config.redis_shard_prefix = get_env_var("REDIS_SHARD_PREFIX", "soul.ingestor.shards");
     
     // Solana RPC URLs (comma-separated)
     std::string rpc_urls_str = get_env_var("SOLANA_RPC_URLS", 
         "https://api.mainnet-beta.solana.com,https://solana-api.projectserum.com,https://rpc.ankr.com/solana");
     config.solana_rpc_urls = split_string(rpc_urls_str, ',');
     
+    // Solana WebSocket URLs (comma-separated, optional)
+    config.solana_ws_urls = split_string(get_env_var("SOLANA_WS_URLS", ""), ',');
+    
+    // On-chain account streaming
+    config.account_subscribe_enabled = get_env_var("ACCOUNT_SUBSCRIBE_ENABLED", "true") == "true";
+    config.account_subscribe_top_n = std::stoi(get_env_var("ACCOUNT_SUBSCRIBE_TOP_N", "200"));
+    
     // DEX APIs
     config.raydium_api_url = get_env_var("RAYDIUM_API_URL", "https://api.raydium.io/v2");
     config.orca_api_url = get_env_var("ORCA_API_URL", "https://api.orca.so/v1");
@@ -38,12 +66,26 @@ Config Config::from_env() {
     config.global_tick_seconds = std::stoi(get_env_var("GLOBAL_TICK_SECONDS", "60"));
     config.ohlcv_interval_minutes = std::stoi(get_env_var("OHLCV_INTERVAL_MINUTES", "5"));
     config.snapshot_persist_minutes = std::stoi(get_env_var("SNAPSHOT_PERSIST_MINUTES", "5"));
+    config.reserve_refresh_seconds = std::stoi(get_env_var("RESERVE_REFRESH_SECONDS", "5"));
+    config.cold_refresh_seconds = std::stoi(get_env_var("COLD_REFRESH_SECONDS", "15"));
+    config.price_check_minutes = std::stoi(get_env_var("PRICE_CHECK_MINUTES", "15"));
+    config.price_check_samples = std::stoi(get_env_var("PRICE_CHECK_SAMPLES", "5"));
     
     // Rate limiting
     config.max_concurrent_requests = std::stoi(get_env_var("MAX_CONCURRENT_REQUESTS", "10"));
+    config.pool_fetch_rps = std::stoi(get_env_var("POOL_FETCH_RPS", "5"));
     config.base_backoff_seconds = std::stod(get_env_var("BASE_BACKOFF_SECONDS", "1.0"));
     config.max_backoff_seconds = std::stod(get_env_var("MAX_BACKOFF_SECONDS", "300.0"));
     
+    // Warm start
+    config.warm_start_enabled = get_env_var("WARM_START_ENABLED", "true") == "true";
+    config.warm_start_file = get_env_var("WARM_START_FILE", "/var/lib/soulscout/ingestor_state.json");
+    
+    // HTTP archive
+    config.http_archive_mode = get_env_var("HTTP_ARCHIVE_MODE", "off");
+    config.http_archive_dir = get_env_var("HTTP_ARCHIVE_DIR", "/var/lib/soulscout/http_archive");
+    config.http_replay_speed = std::stod(get_env_var("HTTP_REPLAY_SPEED", "1.0"));
+    
     // Cache
     config.pool_cache_max_size = std::stoi(get_env_var("POOL_CACHE_MAX_SIZE", "10000"));
     config.pool_cache_ttl_minutes = std::stoi(get_env_var("POOL_CACHE_TTL_MINUTES", "30"));
@@ -72,9 +114,37 @@ void Config::validate() const {
         throw std::runtime_error("Global tick interval must be at least 10 seconds");
     }
     
+    if (reserve_refresh_seconds < 0 || cold_refresh_seconds < 0) {
+        throw std::runtime_error("Reserve refresh intervals must not be negative");
+    }
+    
+    if (price_check_minutes < 0 || price_check_samples < 0) {
+        throw std::runtime_error("Price check settings must not be negative");
+    }
+    
+    if (account_subscribe_top_n < 0) {
+        throw std::runtime_error("Account subscribe top-N must not be negative");
+    }
+    
     if (max_concurrent_requests < 1 || max_concurrent_requests > 100) {
         throw std::runtime_error("Max concurrent requests must be between 1 and 100");
     }
     
+    if (sharding_enabled && (shard_count < 1 || shard_lease_seconds < 6 || instance_id.empty())) {
+        throw std::runtime_error("Sharding needs at least 1 shard, leases of at least 6 seconds and an instance ID");
+    }
+    
+    if (http_archive_mode != "off" && http_archive_mode != "capture" && http_archive_mode != "replay") {
+        throw std::runtime_error("HTTP archive mode must be off, capture or replay");
+    }
+    
+    if (http_replay_speed < 0.0) {
+        throw std::runtime_error("HTTP replay speed must not be negative");
+    }
+    
+    if (pool_fetch_rps < 1) {
+        throw std::runtime_error("Pool fetch rate must be at least 1 request per second");
+    }
+    
     spdlog::info("Configuration validated successfully");
 }
@@ -17,6 +17,14 @@ public:
     int redis_port = 6379;
     std::string redis_password;
     std::string redis_stream = "soul.market.updates";
+    std::string redis_watchlist_key = "soul.watchlist";  // mints analytics is watching
+    
+    // Horizontal sharding across ingestor instances (leases held in Redis)
+    bool sharding_enabled = false;
+    int shard_count = 64;
+    int shard_lease_seconds = 15;
+    std::string instance_id;  // defaults to <hostname>-<pid>
+    std::string redis_shard_prefix = "soul.ingestor.shards";
     
     // Solana RPC endpoints (rotation on failure)
     std::vector<std::string> solana_rpc_urls = {
@@ -25,6 +33,13 @@ public:
         "https://rpc.ankr.com/solana"
     };
     
+    // Solana WebSocket endpoints (derived from solana_rpc_urls when empty)
+    std::vector<std::string> solana_ws_urls;
+    
+    // On-chain account streaming
+    bool account_subscribe_enabled = true;
+    int account_subscribe_top_n = 200;
+    
     // DEX endpoints
     std::string raydium_api_url = "https://api.raydium.io/v2";
     std::string orca_api_url = "https://api.orca.so/v1";
@@ -38,12 +53,28 @@ public:
     int global_tick_seconds = 60;
     int ohlcv_interval_minutes = 5;
     int snapshot_persist_minutes = 5;
+    int reserve_refresh_seconds = 5;  // fastest per-pool refresh for hot pools, 0 disables
+    int cold_refresh_seconds = 15;    // on-chain reserve sweep of all other pools, 0 disables
+    int price_check_minutes = 15;     // Jupiter sanity check of graph prices, 0 disables
+    int price_check_samples = 5;      // mints quoted per sanity check
     
     // Rate limiting
     int max_concurrent_requests = 10;
+    int pool_fetch_rps = 5;  // budget for targeted per-pool DEX API fetches
     double base_backoff_seconds = 1.0;
     double max_backoff_seconds = 300.0;
     
+    // Warm start: local state file written with each snapshot (empty disables
+    // it; Postgres is then the only warm-start source)
+    bool warm_start_enabled = true;
+    std::string warm_start_file = "/var/lib/soulscout/ingestor_state.json";
+    
+    // HTTP response archive: "off", "capture" or "replay" (offline, from
+    // http_archive_dir at http_replay_speed x real time; 0 = no pacing)
+    std::string http_archive_mode = "off";
+    std::string http_archive_dir = "/var/lib/soulscout/http_archive";
+    double http_replay_speed = 1.0;
+    
     // Cache settings
     int pool_cache_max_size = 10000;
     int pool_cache_ttl_minutes = 30;
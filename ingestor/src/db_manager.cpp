@@ -186,6 +186,56 @@ bool DatabaseManager::save_pool_snapshot(const std::vector<PoolInfo>& pools) {
     }, "save_pool_snapshot");
 }
 
+std::vector<PoolInfo> DatabaseManager::load_recent_pools(std::chrono::minutes max_age) {
+    std::vector<PoolInfo> pools;
+    
+    try {
+        auto conn = get_connection();
+        pqxx::work txn(*conn);
+        
+        auto result = txn.exec_params(
+            "SELECT p.pool_id, p.dex_name, p.pool_type, p.token_a_address, p.token_b_address, "
+            "p.reserve_a, p.reserve_b, p.tvl_usd, p.volume_24h_usd, p.price_token_a_in_b, "
+            "p.price_token_b_in_a, p.price_impact_1pct, "
+            "EXTRACT(EPOCH FROM p.last_updated)::BIGINT AS updated_epoch, "
+            "ta.symbol AS symbol_a, ta.decimals AS decimals_a, "
+            "tb.symbol AS symbol_b, tb.decimals AS decimals_b "
+            "FROM pools p "
+            "JOIN tokens ta ON ta.address = p.token_a_address "
+            "JOIN tokens tb ON tb.address = p.token_b_address "
+            "WHERE p.last_updated > NOW() - make_interval(mins => $1)",
+            static_cast<int>(max_age.count())
+        );
+        
+        pools.reserve(result.size());
+        for (const auto& row : result) {
+            PoolInfo pool;
+            pool.pool_id = row["pool_id"].as<std::string>();
+            pool.dex_name = row["dex_name"].as<std::string>();
+            pool.pool_type = row["pool_type"].as<std::string>();
+            pool.token_a.address = row["token_a_address"].as<std::string>();
+            pool.token_a.symbol = row["symbol_a"].as<std::string>();
+            pool.token_a.decimals = row["decimals_a"].as<int>();
+            pool.token_b.address = row["token_b_address"].as<std::string>();
+            pool.token_b.symbol = row["symbol_b"].as<std::string>();
+            pool.token_b.decimals = row["decimals_b"].as<int>();
+            pool.reserve_a = row["reserve_a"].as<double>();
+            pool.reserve_b = row["reserve_b"].as<double>();
+            pool.tvl_usd = row["tvl_usd"].is_null() ? 0.0 : row["tvl_usd"].as<double>();
+            pool.volume_24h_usd = row["volume_24h_usd"].is_null() ? 0.0 : row["volume_24h_usd"].as<double>();
+            pool.price_token_a_in_b = row["price_token_a_in_b"].is_null() ? 0.0 : row["price_token_a_in_b"].as<double>();
+            pool.price_token_b_in_a = row["price_token_b_in_a"].is_null() ? 0.0 : row["price_token_b_in_a"].as<double>();
+            pool.price_impact_1pct = row["price_impact_1pct"].is_null() ? 0.0 : row["price_impact_1pct"].as<double>();
+            pool.last_updated = std::chrono::system_clock::from_time_t(row["updated_epoch"].as<time_t>());
+            pools.push_back(std::move(pool));
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Error loading recent pools: {}", e.what());
+    }
+    
+    return pools;
+}
+
 bool DatabaseManager::save_ohlcv_bars(const std::vector<OHLCVBar>& bars) {
     if (bars.empty()) {
         return true;
@@ -230,6 +280,75 @@ bool DatabaseManager::save_ohlcv_bars(const std::vector<OHLCVBar>& bars) {
     }, "save_ohlcv_bars");
 }
 
+bool DatabaseManager::copy_ohlcv_bars(const std::vector<OHLCVBar>& bars, bool overwrite) {
+    if (bars.empty()) {
+        return true;
+    }
+    
+    return execute_with_retry([this, &bars, overwrite]() {
+        auto conn = get_connection();
+        pqxx::work txn(*conn);
+        
+        txn.exec(R"(
+            CREATE TEMP TABLE backfill_stage (
+                seq BIGSERIAL,
+                pool_id TEXT NOT NULL,
+                ts BIGINT NOT NULL,
+                interval_minutes INTEGER NOT NULL,
+                open DOUBLE PRECISION NOT NULL,
+                high DOUBLE PRECISION NOT NULL,
+                low DOUBLE PRECISION NOT NULL,
+                close DOUBLE PRECISION NOT NULL,
+                volume DOUBLE PRECISION
+            ) ON COMMIT DROP
+        )");
+        
+        auto stream = pqxx::stream_to::table(txn, {"backfill_stage"},
+            {"pool_id", "ts", "interval_minutes", "open", "high", "low", "close", "volume"});
+        for (const auto& bar : bars) {
+            stream.write_values(
+                bar.pool_id,
+                static_cast<int64_t>(std::chrono::system_clock::to_time_t(bar.timestamp)),
+                bar.interval_minutes,
+                bar.open,
+                bar.high,
+                bar.low,
+                bar.close,
+                bar.volume
+            );
+        }
+        stream.complete();
+        
+        // Overlapping inputs can stage the same bar twice, and ON CONFLICT DO UPDATE
+        // can't touch a row twice in one statement: keep the last staged copy.
+        // base/quote tokens come from the pool row the foreign key requires anyway
+        std::string on_conflict = overwrite
+            ? "DO UPDATE SET "
+              "open = EXCLUDED.open, "
+              "high = EXCLUDED.high, "
+              "low = EXCLUDED.low, "
+              "close = EXCLUDED.close, "
+              "volume_usd = EXCLUDED.volume_usd"
+            : "DO NOTHING";
+        auto result = txn.exec(
+            "INSERT INTO ohlcv_bars (pool_id, timestamp, interval_minutes, open, high, low, close, "
+            "volume_usd, base_token, quote_token) "
+            "SELECT s.pool_id, to_timestamp(s.ts), s.interval_minutes, s.open, s.high, s.low, s.close, "
+            "s.volume, p.token_a_address, p.token_b_address "
+            "FROM (SELECT DISTINCT ON (pool_id, ts, interval_minutes) * "
+            "      FROM backfill_stage "
+            "      ORDER BY pool_id, ts, interval_minutes, seq DESC) s "
+            "JOIN pools p ON p.pool_id = s.pool_id "
+            "ON CONFLICT (pool_id, timestamp, interval_minutes) " + on_conflict
+        );
+        
+        txn.commit();
+        spdlog::debug("Copied {} OHLCV bars, {} skipped (duplicate, unknown pool or already stored)",
+                     result.affected_rows(), bars.size() - result.affected_rows());
+        return true;
+    }, "copy_ohlcv_bars");
+}
+
 bool DatabaseManager::save_tokens(const std::vector<TokenInfo>& tokens) {
     if (tokens.empty()) {
         return true;
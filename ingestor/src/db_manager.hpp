@@ -8,6 +8,7 @@
 #include <string>
 #include <mutex>
 #include <optional>
+#include <chrono>
 
 class DatabaseManager {
 public:
@@ -17,12 +18,20 @@ public:
     // Initialize database tables if they don't exist
     bool initialize_schema();
     
-    // Save a snapshot of all pools
+    // Upsert the given pools and their tokens (the service passes only changed rows)
     bool save_pool_snapshot(const std::vector<PoolInfo>& pools);
     
+    // Pools persisted within max_age, with their token symbols and decimals
+    std::vector<PoolInfo> load_recent_pools(std::chrono::minutes max_age);
+    
     // Save OHLCV bars
     bool save_ohlcv_bars(const std::vector<OHLCVBar>& bars);
     
+    // Bulk-load historical bars through COPY into a staging table, one
+    // transaction per call. Bars for pools missing from the pools table are
+    // dropped; existing bars are kept unless overwrite is set.
+    bool copy_ohlcv_bars(const std::vector<OHLCVBar>& bars, bool overwrite);
+    
     // Save token information
     bool save_tokens(const std::vector<TokenInfo>& tokens);
     
@@ -1,4 +1,6 @@
 #include "dex_client.hpp"
+#include "amm_kernel.hpp"
+#include "pool_table.hpp"
 #include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
@@ -8,34 +10,32 @@
 
 class DexClient::Impl {
 public:
-    explicit Impl(const Config& config) 
+    Impl(const Config& config, PoolCache* cache, HttpArchive* archive) 
         : config_(config), 
+          cache_(cache),
+          archive_(archive),
           rng_(std::random_device{}()),
           backoff_seconds_(config.base_backoff_seconds) {}
-
+    
     std::vector<PoolInfo> fetch_pools() {
-        std::vector<PoolInfo> all_pools;
+        PoolTable table;
         
         // Fetch from Raydium
-        auto raydium_pools = fetch_raydium_pools();
-        all_pools.insert(all_pools.end(), raydium_pools.begin(), raydium_pools.end());
+        for (auto& pool : fetch_raydium_pools()) {
+            table.append(std::move(pool));
+        }
         
         // Fetch from Orca
-        auto orca_pools = fetch_orca_pools();
-        all_pools.insert(all_pools.end(), orca_pools.begin(), orca_pools.end());
+        for (auto& pool : fetch_orca_pools()) {
+            table.append(std::move(pool));
+        }
         
-        spdlog::info("Fetched a total of {} pools from all DEXs", all_pools.size());
+        spdlog::info("Fetched a total of {} pools from all DEXs", table.size());
         
-        // Filter pools by TVL and volume thresholds
-        all_pools.erase(
-            std::remove_if(all_pools.begin(), all_pools.end(), 
-                [this](const PoolInfo& pool) {
-                    return pool.tvl_usd < config_.min_tvl_threshold || 
-                           pool.volume_24h_usd < config_.min_volume_threshold;
-                }
-            ),
-            all_pools.end()
-        );
+        // Single columnar pass over the TVL and volume thresholds; only the
+        // selected rows are materialised
+        auto selection = table.select_liquid(config_.min_tvl_threshold, config_.min_volume_threshold);
+        auto all_pools = table.take(selection);
         
         spdlog::info("{} pools remain after filtering by TVL and volume thresholds", all_pools.size());
         
@@ -43,6 +43,7 @@ public:
         for (auto& pool : all_pools) {
             calculate_additional_metrics(pool);
         }
+        amm::compute_pool_impacts(all_pools);
         
         return all_pools;
     }
@@ -51,21 +52,23 @@ public:
         // Try Raydium first
         auto raydium_pool = fetch_raydium_pool_by_id(pool_id);
         if (raydium_pool) {
-            calculate_additional_metrics(*raydium_pool);
-            return raydium_pool;
+            return with_metrics(std::move(*raydium_pool));
         }
         
         // Try Orca if not found in Raydium
         auto orca_pool = fetch_orca_pool_by_id(pool_id);
         if (orca_pool) {
-            calculate_additional_metrics(*orca_pool);
-            return orca_pool;
+            return with_metrics(std::move(*orca_pool));
         }
         
         return std::nullopt;
     }
     
     std::vector<PoolInfo> fetch_pools_by_token(const std::string& token_mint) {
+        if (cache_) {
+            return fetch_pools_by_token_cached(token_mint);
+        }
+        
         std::vector<PoolInfo> token_pools;
         
         // Fetch all pools and filter by token
@@ -81,6 +84,24 @@ public:
     }
 
 private:
+    std::vector<PoolInfo> fetch_pools_by_token_cached(const std::string& token_mint) {
+        auto token_pools = cache_->get_pools_by_token(token_mint);
+        
+        // Anything the last bulk tick refreshed is fresh enough; refetch the rest one by one
+        auto stale_before = std::chrono::system_clock::now() - std::chrono::seconds(config_.global_tick_seconds);
+        for (auto& pool : token_pools) {
+            if (pool.last_updated >= stale_before) continue;
+            
+            auto fresh = fetch_pool_by_id(pool.pool_id);
+            if (fresh) {
+                cache_->update_pool(*fresh);
+                pool = std::move(*fresh);
+            }
+        }
+        
+        return token_pools;
+    }
+    
     std::vector<PoolInfo> fetch_raydium_pools() {
         std::vector<PoolInfo> pools;
         try {
@@ -90,7 +111,7 @@ private:
             auto url = config_.raydium_api_url + "/pools";
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto response = make_request_with_backoff("GET " + url, [&]() {
                 return cpr::Get(
                     cpr::Url{url},
                     cpr::Timeout{30000},
@@ -157,6 +178,10 @@ private:
                         pool.reserve_b = std::stod(item["quoteReserve"].get<std::string>());
                     }
                     
+                    // Vault accounts (used for on-chain reserve updates)
+                    pool.vault_a = item.value("baseVault", "");
+                    pool.vault_b = item.value("quoteVault", "");
+                    
                     pool.last_updated = std::chrono::system_clock::now();
                     
                     // Store raw data for debugging
@@ -191,7 +216,7 @@ private:
             auto url = config_.raydium_api_url + "/pool/" + pool_id;
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto response = make_request_with_backoff("GET " + url, [&]() {
                 return cpr::Get(
                     cpr::Url{url},
                     cpr::Timeout{30000},
@@ -247,6 +272,10 @@ private:
                 pool.reserve_b = std::stod(item["quoteReserve"].get<std::string>());
             }
             
+            // Vault accounts (used for on-chain reserve updates)
+            pool.vault_a = item.value("baseVault", "");
+            pool.vault_b = item.value("quoteVault", "");
+            
             pool.last_updated = std::chrono::system_clock::now();
             
             // Store raw data for debugging
@@ -262,7 +291,7 @@ private:
         
         return std::nullopt;
     }
-
+    
     std::vector<PoolInfo> fetch_orca_pools() {
         std::vector<PoolInfo> pools;
         try {
@@ -272,7 +301,7 @@ private:
             auto url = config_.orca_api_url + "/allPools";
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto response = make_request_with_backoff("GET " + url, [&]() {
                 return cpr::Get(
                     cpr::Url{url},
                     cpr::Timeout{30000},
@@ -345,6 +374,10 @@ private:
                         pool.reserve_b = reserves.value("tokenB", 0.0);
                     }
                     
+                    // Vault accounts (used for on-chain reserve updates)
+                    pool.vault_a = item.value("tokenVaultA", "");
+                    pool.vault_b = item.value("tokenVaultB", "");
+                    
                     pool.last_updated = std::chrono::system_clock::now();
                     
                     // Store raw data for debugging
@@ -379,7 +412,7 @@ private:
             auto url = config_.orca_api_url + "/pool/" + pool_id;
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto response = make_request_with_backoff("GET " + url, [&]() {
                 return cpr::Get(
                     cpr::Url{url},
                     cpr::Timeout{30000},
@@ -442,6 +475,10 @@ private:
                 pool.reserve_b = reserves.value("tokenB", 0.0);
             }
             
+            // Vault accounts (used for on-chain reserve updates)
+            pool.vault_a = json_res.value("tokenVaultA", "");
+            pool.vault_b = json_res.value("tokenVaultB", "");
+            
             pool.last_updated = std::chrono::system_clock::now();
             
             // Store raw data for debugging
@@ -458,6 +495,13 @@ private:
         return std::nullopt;
     }
     
+    std::optional<PoolInfo> with_metrics(PoolInfo pool) {
+        calculate_additional_metrics(pool);
+        std::vector<PoolInfo> batch{std::move(pool)};
+        amm::compute_pool_impacts(batch);
+        return std::move(batch.front());
+    }
+    
     // Helper method to calculate additional metrics for a pool
     void calculate_additional_metrics(PoolInfo& pool) {
         // Calculate fee rate based on pool type
@@ -467,30 +511,7 @@ private:
             pool.fee_rate = 0.003; // 0.3% for constant product pools
         }
         
-        // Calculate price impact for 1% of liquidity
-        if (pool.reserve_a > 0 && pool.reserve_b > 0) {
-            // For constant product pools (x*y=k), calculate price impact
-            if (pool.pool_type == "constant-product") {
-                // Calculate k
-                double k = pool.reserve_a * pool.reserve_b;
-                
-                // Calculate new reserves after 1% swap of token A
-                double delta_a = pool.reserve_a * 0.01;
-                double new_reserve_a = pool.reserve_a + delta_a;
-                double new_reserve_b = k / new_reserve_a;
-                double delta_b = pool.reserve_b - new_reserve_b;
-                
-                // Calculate price impact
-                double initial_price = pool.reserve_b / pool.reserve_a;
-                double new_price = new_reserve_b / new_reserve_a;
-                pool.price_impact_1pct = std::abs((new_price - initial_price) / initial_price) * 100.0;
-            }
-            // For stable pools, use a simplified model
-            else if (pool.pool_type == "stable") {
-                // Stable pools have lower price impact, use a simplified estimate
-                pool.price_impact_1pct = 0.1; // 0.1% as a conservative estimate
-            }
-        }
+        // Price impact is computed in batches by amm::compute_pool_impacts
         
         // Calculate APR (simplified)
         if (pool.volume_24h_usd > 0 && pool.tvl_usd > 0) {
@@ -499,10 +520,24 @@ private:
             pool.apr = 0.0;
         }
     }
-
+    
     // Helper method to make HTTP requests with exponential backoff and jitter
     template<typename RequestFunc>
-    cpr::Response make_request_with_backoff(RequestFunc request_func) {
+    cpr::Response make_request_with_backoff(const std::string& request_key, RequestFunc request_func) {
+        // Offline replay never touches the network or backs off
+        if (archive_ && archive_->mode() == HttpArchive::Mode::Replay) {
+            cpr::Response response;
+            auto archived = archive_->replay(request_key);
+            if (archived) {
+                response.status_code = archived->status_code;
+                response.text = std::move(archived->body);
+            } else {
+                response.error.code = cpr::ErrorCode::UNKNOWN_ERROR;
+                response.error.message = "no recorded response for " + request_key;
+            }
+            return response;
+        }
+        
         int attempts = 0;
         const int max_attempts = 5;
         
@@ -511,12 +546,14 @@ private:
             
             // Check if request was successful
             if (!response.error && (response.status_code == 200 || response.status_code == 201)) {
+                capture_response(request_key, response);
                 return response;
             }
             
             // If we've reached max attempts, return the last response
             if (++attempts >= max_attempts) {
                 spdlog::warn("Max request attempts reached");
+                capture_response(request_key, response);
                 return response;
             }
             
@@ -539,18 +576,26 @@ private:
         return cpr::Response();
     }
     
+    void capture_response(const std::string& request_key, const cpr::Response& response) {
+        if (archive_ && !response.error) {
+            archive_->record(request_key, response.status_code, response.text);
+        }
+    }
+    
     // Helper method to increase backoff time
     void increase_backoff() {
         backoff_seconds_ = std::min(backoff_seconds_ * 2.0, config_.max_backoff_seconds);
     }
-
+    
     const Config& config_;
+    PoolCache* cache_;
+    HttpArchive* archive_;
     std::mt19937 rng_;
     double backoff_seconds_;
 };
 
 // --- PIMPL forward declarations ---
-DexClient::DexClient(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+DexClient::DexClient(const Config& config, PoolCache* cache, HttpArchive* archive) : pImpl_(std::make_unique<Impl>(config, cache, archive)) {}
 DexClient::~DexClient() = default;
 std::vector<PoolInfo> DexClient::fetch_pools() { return pImpl_->fetch_pools(); }
 std::optional<PoolInfo> DexClient::fetch_pool_by_id(const std::string& pool_id) { return pImpl_->fetch_pool_by_id(pool_id); }
@@ -3,6 +3,8 @@
 
 #include "config.hpp"
 #include "types.hpp"
+#include "pool_cache.hpp"
+#include "http_archive.hpp"
 #include <vector>
 #include <memory>
 #include <string>
@@ -12,7 +14,9 @@
 
 class DexClient {
 public:
-    explicit DexClient(const Config& config);
+    // When a cache is given, token lookups are answered from its token index;
+    // an archive captures or replays every DEX API response
+    explicit DexClient(const Config& config, PoolCache* cache = nullptr, HttpArchive* archive = nullptr);
     ~DexClient();
 
     // Fetches pools from all configured DEXs (Raydium, Orca)
@@ -21,7 +25,8 @@ public:
     // Fetch a specific pool by ID
     std::optional<PoolInfo> fetch_pool_by_id(const std::string& pool_id);
     
-    // Fetch pools for a specific token
+    // Fetch pools for a specific token. With a cache, only entries older than
+    // the global tick are re-fetched; without one, all pools are downloaded.
     std::vector<PoolInfo> fetch_pools_by_token(const std::string& token_mint);
 
 private:
@@ -0,0 +1,446 @@
+#include "http_archive.hpp"
+#include <spdlog/spdlog.h>
+#include <zstd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Start a new segment once this much uncompressed data went into the current one
+constexpr size_t kSegmentBytes = 256 * 1024 * 1024;
+
+// End the zstd frame once this much went into it. Frames decode on their own,
+// so replay can read one record by decoding only the frame holding it.
+constexpr size_t kFrameBytes = 4 * 1024 * 1024;
+
+// Decoded frames replay keeps; consumption follows the recorded order closely,
+// so a few cover the interleaving of the request keys
+constexpr size_t kCachedFrames = 4;
+
+// Compressed bytes read from a segment file at a time
+constexpr size_t kReadChunk = 1024 * 1024;
+
+constexpr int kCompressionLevel = 3;
+
+constexpr uint32_t kNoSegment = UINT32_MAX;
+
+// Record framing inside the zstd stream (host byte order):
+// u64 timestamp_ms | i32 status | u32 key_len | u32 body_len | key | body
+struct RecordHeader {
+    uint64_t timestamp_ms;
+    int32_t status;
+    uint32_t key_len;
+    uint32_t body_len;
+};
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+HttpArchive::Mode parse_mode(const std::string& mode) {
+    if (mode == "capture") return HttpArchive::Mode::Capture;
+    if (mode == "replay") return HttpArchive::Mode::Replay;
+    return HttpArchive::Mode::Off;
+}
+
+} // namespace
+
+class HttpArchive::Impl {
+public:
+    explicit Impl(const Config& config)
+        : config_(config),
+          mode_(parse_mode(config.http_archive_mode)) {
+        if (mode_ == Mode::Replay) {
+            load_segments();
+        } else if (mode_ == Mode::Capture) {
+            std::filesystem::create_directories(config_.http_archive_dir);
+            spdlog::info("Capturing HTTP responses to {}", config_.http_archive_dir);
+        }
+    }
+    
+    ~Impl() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        close_segment();
+    }
+    
+    Mode mode() const {
+        return mode_;
+    }
+    
+    void record(const std::string& request_key, long status_code, const std::string& body) {
+        if (mode_ != Mode::Capture) {
+            return;
+        }
+        
+        RecordHeader header{static_cast<uint64_t>(now_ms()), static_cast<int32_t>(status_code),
+                            static_cast<uint32_t>(request_key.size()), static_cast<uint32_t>(body.size())};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+            if (!cctx_ || segment_bytes_ >= kSegmentBytes) {
+                close_segment();
+                open_segment();
+            }
+            
+            compress(&header, sizeof(header), ZSTD_e_continue);
+            compress(request_key.data(), request_key.size(), ZSTD_e_continue);
+            
+            // Flush per record so a crash loses at most the record being
+            // written, and end the frame at a record boundary once it is full
+            size_t record_bytes = sizeof(header) + request_key.size() + body.size();
+            frame_bytes_ += record_bytes;
+            bool end_frame = frame_bytes_ >= kFrameBytes;
+            compress(body.data(), body.size(), end_frame ? ZSTD_e_end : ZSTD_e_flush);
+            if (end_frame) {
+                frame_bytes_ = 0;
+            }
+            segment_bytes_ += record_bytes;
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to capture HTTP response for {}: {}", request_key, e.what());
+            close_segment();
+        }
+    }
+    
+    std::optional<ArchivedResponse> replay(const std::string& request_key) {
+        if (mode_ != Mode::Replay) {
+            return std::nullopt;
+        }
+        
+        RecordRef recorded;
+        std::string body;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = recordings_.find(request_key);
+            if (it == recordings_.end() || it->second.empty()) {
+                spdlog::warn("No recorded response left for {}", request_key);
+                return std::nullopt;
+            }
+            recorded = it->second.front();
+            it->second.pop_front();
+            
+            try {
+                body = read_body(recorded);
+            } catch (const std::exception& e) {
+                spdlog::error("Failed to read recorded response for {}: {}", request_key, e.what());
+                return std::nullopt;
+            }
+            last_replayed_ms_ = std::max(last_replayed_ms_, recorded.timestamp_ms);
+            replayed_++;
+        }
+        
+        // Replay on the recorded timeline, compressed by the speed factor
+        if (config_.http_replay_speed > 0.0) {
+            auto offset = std::chrono::duration<double, std::milli>(
+                static_cast<double>(recorded.timestamp_ms - first_timestamp_ms_) / config_.http_replay_speed);
+            std::this_thread::sleep_until(replay_start_ +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+        }
+        
+        return ArchivedResponse{recorded.status, std::move(body)};
+    }
+    
+    std::chrono::system_clock::time_point last_replayed_at() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto ms = std::max<int64_t>(last_replayed_ms_, 0);
+        return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+    }
+    
+    uint64_t replayed_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return replayed_;
+    }
+
+private:
+    // Where a recorded body sits: the frame holding it, by the frame's byte
+    // offset in its segment file, and the body's offset in the decoded frame
+    struct RecordRef {
+        int64_t timestamp_ms = 0;
+        long status = 0;
+        uint32_t segment = kNoSegment;
+        uint64_t frame_offset = 0;
+        uint64_t body_offset = 0;
+        uint32_t body_len = 0;
+    };
+    
+    struct DecodedFrame {
+        uint32_t segment;
+        uint64_t frame_offset;
+        std::string data;
+    };
+    
+    void open_segment() {
+        auto path = std::filesystem::path(config_.http_archive_dir) /
+                    ("http-" + std::to_string(now_ms()) + ".zst");
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            throw std::runtime_error("cannot open " + path.string());
+        }
+        
+        cctx_ = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, kCompressionLevel);
+        segment_bytes_ = 0;
+        frame_bytes_ = 0;
+        spdlog::info("Opened HTTP capture segment {}", path.string());
+    }
+    
+    void close_segment() {
+        if (cctx_) {
+            try {
+                compress(nullptr, 0, ZSTD_e_end);
+            } catch (const std::exception& e) {
+                spdlog::warn("Failed to finish HTTP capture segment: {}", e.what());
+            }
+            ZSTD_freeCCtx(cctx_);
+            cctx_ = nullptr;
+        }
+        if (out_.is_open()) {
+            out_.close();
+        }
+    }
+    
+    void compress(const void* data, size_t size, ZSTD_EndDirective mode) {
+        ZSTD_inBuffer input{data, size, 0};
+        std::vector<char> buffer(ZSTD_CStreamOutSize());
+        bool finished = false;
+        while (!finished) {
+            ZSTD_outBuffer output{buffer.data(), buffer.size(), 0};
+            size_t remaining = ZSTD_compressStream2(cctx_, &output, &input, mode);
+            if (ZSTD_isError(remaining)) {
+                throw std::runtime_error(ZSTD_getErrorName(remaining));
+            }
+            out_.write(buffer.data(), static_cast<std::streamsize>(output.pos));
+            
+            finished = mode == ZSTD_e_continue ? input.pos == input.size : remaining == 0;
+        }
+        if (mode != ZSTD_e_continue) {
+            out_.flush();
+        }
+    }
+    
+    void load_segments() {
+        if (std::filesystem::is_directory(config_.http_archive_dir)) {
+            for (const auto& entry : std::filesystem::directory_iterator(config_.http_archive_dir)) {
+                if (entry.path().extension() == ".zst") {
+                    segments_.push_back(entry.path());
+                }
+            }
+        }
+        
+        // Segment names carry their start time, so name order is time order
+        std::sort(segments_.begin(), segments_.end());
+        
+        size_t records = 0;
+        first_timestamp_ms_ = -1;
+        for (uint32_t i = 0; i < segments_.size(); ++i) {
+            records += index_segment(i);
+        }
+        replay_start_ = std::chrono::steady_clock::now();
+        
+        spdlog::info("Replaying {} recorded HTTP responses for {} requests from {} segments at {}x",
+                    records, recordings_.size(), segments_.size(), config_.http_replay_speed);
+    }
+    
+    // Decode a segment once, front to back, keeping each record's key and
+    // position but not its body. Bodies are read back on demand, so memory
+    // holds the index and a few decoded frames rather than the capture.
+    size_t index_segment(uint32_t segment) {
+        const auto& path = segments_[segment];
+        std::ifstream in(path, std::ios::binary);
+        
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        std::vector<char> chunk(kReadChunk);
+        std::vector<char> buffer(ZSTD_DStreamOutSize());
+        
+        uint64_t chunk_start = 0;      // file offset of chunk[0]
+        uint64_t frame_offset = 0;     // file offset of the frame being decoded
+        uint64_t frame_pos = 0;        // bytes of that frame decoded so far
+        
+        // The record being parsed: its header and key are gathered, its body
+        // skipped; it is indexed once the body is complete
+        std::string key;
+        RecordHeader header{};
+        size_t header_got = 0;
+        uint64_t body_left = 0;
+        RecordRef ref;
+        
+        size_t records = 0;
+        bool corrupt = false;
+        while (!corrupt && in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            size_t got = static_cast<size_t>(in.gcount());
+            if (got == 0) break;
+            
+            ZSTD_inBuffer input{chunk.data(), got, 0};
+            bool more = true;
+            while (more) {
+                ZSTD_outBuffer output{buffer.data(), buffer.size(), 0};
+                size_t result = ZSTD_decompressStream(dctx, &output, &input);
+                if (ZSTD_isError(result)) {
+                    // A segment cut short by a crash still yields every fully flushed record
+                    spdlog::warn("Stopped reading {} at a corrupt block: {}", path.string(), ZSTD_getErrorName(result));
+                    corrupt = true;
+                    break;
+                }
+                
+                const char* data = buffer.data();
+                size_t size = output.pos;
+                while (size > 0) {
+                    size_t take;
+                    if (header_got < sizeof(header)) {
+                        take = std::min(sizeof(header) - header_got, size);
+                        std::memcpy(reinterpret_cast<char*>(&header) + header_got, data, take);
+                        header_got += take;
+                    } else if (key.size() < header.key_len) {
+                        take = std::min<size_t>(header.key_len - key.size(), size);
+                        key.append(data, take);
+                    } else {
+                        take = static_cast<size_t>(std::min<uint64_t>(body_left, size));
+                        body_left -= take;
+                    }
+                    data += take;
+                    size -= take;
+                    frame_pos += take;
+                    
+                    // Header and key complete: the body starts here
+                    if (header_got == sizeof(header) && key.size() == header.key_len && ref.segment == kNoSegment) {
+                        ref.timestamp_ms = static_cast<int64_t>(header.timestamp_ms);
+                        ref.status = header.status;
+                        ref.segment = segment;
+                        ref.frame_offset = frame_offset;
+                        ref.body_offset = frame_pos;
+                        ref.body_len = header.body_len;
+                        body_left = header.body_len;
+                    }
+                    
+                    if (ref.segment != kNoSegment && body_left == 0) {
+                        if (first_timestamp_ms_ < 0) {
+                            first_timestamp_ms_ = ref.timestamp_ms;
+                        }
+                        recordings_[key].push_back(ref);
+                        ++records;
+                        
+                        key.clear();
+                        header_got = 0;
+                        ref = RecordRef{};
+                    }
+                }
+                
+                // 0 means a frame just ended; the next starts at this input position
+                if (result == 0) {
+                    frame_offset = chunk_start + input.pos;
+                    frame_pos = 0;
+                }
+                
+                // A full output buffer may hide more data even once the input is consumed
+                more = input.pos < input.size || output.pos == output.size;
+            }
+            chunk_start += got;
+        }
+        ZSTD_freeDCtx(dctx);
+        
+        return records;
+    }
+    
+    // The body of a recorded response, decoding its frame unless it is cached
+    std::string read_body(const RecordRef& ref) {
+        auto cached = std::find_if(frames_.begin(), frames_.end(), [&ref](const DecodedFrame& frame) {
+            return frame.segment == ref.segment && frame.frame_offset == ref.frame_offset;
+        });
+        if (cached == frames_.end()) {
+            if (frames_.size() >= kCachedFrames) {
+                frames_.pop_back();
+            }
+            frames_.push_front(DecodedFrame{ref.segment, ref.frame_offset, decode_frame(ref)});
+            cached = frames_.begin();
+        } else if (cached != frames_.begin()) {
+            frames_.splice(frames_.begin(), frames_, cached);
+            cached = frames_.begin();
+        }
+        
+        const auto& data = cached->data;
+        if (ref.body_offset + ref.body_len > data.size()) {
+            throw std::runtime_error("record runs past its frame in " + segments_[ref.segment].string());
+        }
+        return data.substr(ref.body_offset, ref.body_len);
+    }
+    
+    // Decode from the record's frame start through the end of that frame, or
+    // further if the record continues into the next one (segments written
+    // before frames were capped are a single frame)
+    std::string decode_frame(const RecordRef& ref) {
+        const auto& path = segments_[ref.segment];
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(ref.frame_offset));
+        if (!in) {
+            throw std::runtime_error("cannot seek in " + path.string());
+        }
+        
+        uint64_t needed = ref.body_offset + ref.body_len;
+        std::string data;
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        std::vector<char> chunk(kReadChunk);
+        std::vector<char> buffer(ZSTD_DStreamOutSize());
+        bool done = false;
+        while (!done && in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            size_t got = static_cast<size_t>(in.gcount());
+            if (got == 0) break;
+            
+            ZSTD_inBuffer input{chunk.data(), got, 0};
+            bool more = true;
+            while (more && !done) {
+                ZSTD_outBuffer output{buffer.data(), buffer.size(), 0};
+                size_t result = ZSTD_decompressStream(dctx, &output, &input);
+                if (ZSTD_isError(result)) {
+                    ZSTD_freeDCtx(dctx);
+                    throw std::runtime_error(ZSTD_getErrorName(result));
+                }
+                data.append(buffer.data(), output.pos);
+                done = result == 0 && data.size() >= needed;
+                more = input.pos < input.size || output.pos == output.size;
+            }
+        }
+        ZSTD_freeDCtx(dctx);
+        return data;
+    }
+    
+    const Config& config_;
+    Mode mode_;
+    std::mutex mutex_;
+    
+    // Capture
+    std::ofstream out_;
+    ZSTD_CCtx* cctx_ = nullptr;
+    size_t segment_bytes_ = 0;
+    size_t frame_bytes_ = 0;
+    
+    // Replay
+    std::vector<std::filesystem::path> segments_;
+    std::unordered_map<std::string, std::deque<RecordRef>> recordings_;
+    std::list<DecodedFrame> frames_;  // most recently used first
+    int64_t first_timestamp_ms_ = -1;
+    int64_t last_replayed_ms_ = -1;
+    uint64_t replayed_ = 0;
+    std::chrono::steady_clock::time_point replay_start_;
+};
+
+// --- PIMPL forward declarations ---
+HttpArchive::HttpArchive(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+HttpArchive::~HttpArchive() = default;
+HttpArchive::Mode HttpArchive::mode() const { return pImpl_->mode(); }
+void HttpArchive::record(const std::string& request_key, long status_code, const std::string& body) { pImpl_->record(request_key, status_code, body); }
+std::optional<ArchivedResponse> HttpArchive::replay(const std::string& request_key) { return pImpl_->replay(request_key); }
+std::chrono::system_clock::time_point HttpArchive::last_replayed_at() const { return pImpl_->last_replayed_at(); }
+uint64_t HttpArchive::replayed_count() const { return pImpl_->replayed_count(); }
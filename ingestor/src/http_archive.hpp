@@ -0,0 +1,53 @@
+#pragma once
+
+#include "config.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+struct ArchivedResponse {
+    long status_code = 0;
+    std::string body;
+};
+
+// Capture/replay of raw DEX and Jupiter HTTP responses.
+//
+// Capture appends every response, keyed by its request ("GET <url>",
+// "POST <url> <body>") and timestamped, to zstd-compressed segment files in
+// http_archive_dir, in frames of a few MiB that decode independently. Replay
+// indexes those segments up front, keeping only each record's key and
+// position, and answers each request with the next recorded response for the
+// same key, decoding its frame on demand. Responses are paced to the
+// recorded timeline at http_replay_speed times real time, so the parse ->
+// cache -> publish pipeline can be run offline with production load shapes
+// without holding the capture in memory.
+class HttpArchive {
+public:
+    enum class Mode { Off, Capture, Replay };
+    
+    explicit HttpArchive(const Config& config);
+    ~HttpArchive();
+    
+    Mode mode() const;
+    
+    // Capture mode only; no-op otherwise
+    void record(const std::string& request_key, long status_code, const std::string& body);
+    
+    // Replay mode only: the next recorded response for the key, or nullopt
+    // once the recording has no more responses for it
+    std::optional<ArchivedResponse> replay(const std::string& request_key);
+    
+    // Recording time of the newest response replayed so far (epoch when none),
+    // for tools that rebuild history from a capture
+    std::chrono::system_clock::time_point last_replayed_at() const;
+    
+    // Number of responses replayed so far; a caller whose requests stop moving
+    // it has run past the end of the recording
+    uint64_t replayed_count() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
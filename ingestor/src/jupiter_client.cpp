@@ -8,8 +8,9 @@
 
 class JupiterClient::Impl {
 public:
-    explicit Impl(const Config& config) 
+    Impl(const Config& config, HttpArchive* archive) 
         : config_(config), 
+          archive_(archive),
           rng_(std::random_device{}()),
           backoff_seconds_(config.base_backoff_seconds) {
         // Initialize USDC and USDT mint addresses
@@ -42,11 +43,12 @@ public:
             };
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto body = request_data.dump();
+            auto response = make_request_with_backoff("POST " + url + " " + body, [&]() {
                 return cpr::Post(
                     cpr::Url{url},
                     cpr::Header{{"Content-Type", "application/json"}, {"User-Agent", "SoulScout/1.1"}},
-                    cpr::Body{request_data.dump()},
+                    cpr::Body{body},
                     cpr::Timeout{30000}
                 );
             });
@@ -164,7 +166,8 @@ private:
             auto url = config_.coingecko_api_url + "/simple/token_price/solana";
             
             // Make the request with proper error handling and backoff
-            auto response = make_request_with_backoff([&]() {
+            auto request_key = "GET " + url + "?contract_addresses=" + token_mint + "&vs_currencies=usd";
+            auto response = make_request_with_backoff(request_key, [&]() {
                 return cpr::Get(
                     cpr::Url{url},
                     cpr::Parameters{
@@ -199,7 +202,21 @@ private:
     
     // Helper method to make HTTP requests with exponential backoff and jitter
     template<typename RequestFunc>
-    cpr::Response make_request_with_backoff(RequestFunc request_func) {
+    cpr::Response make_request_with_backoff(const std::string& request_key, RequestFunc request_func) {
+        // Offline replay never touches the network or backs off
+        if (archive_ && archive_->mode() == HttpArchive::Mode::Replay) {
+            cpr::Response response;
+            auto archived = archive_->replay(request_key);
+            if (archived) {
+                response.status_code = archived->status_code;
+                response.text = std::move(archived->body);
+            } else {
+                response.error.code = cpr::ErrorCode::UNKNOWN_ERROR;
+                response.error.message = "no recorded response for " + request_key;
+            }
+            return response;
+        }
+        
         int attempts = 0;
         const int max_attempts = 5;
         
@@ -208,12 +225,14 @@ private:
             
             // Check if request was successful
             if (!response.error && (response.status_code == 200 || response.status_code == 201)) {
+                capture_response(request_key, response);
                 return response;
             }
             
             // If we've reached max attempts, return the last response
             if (++attempts >= max_attempts) {
                 spdlog::warn("Max request attempts reached");
+                capture_response(request_key, response);
                 return response;
             }
             
@@ -236,12 +255,19 @@ private:
         return cpr::Response();
     }
     
+    void capture_response(const std::string& request_key, const cpr::Response& response) {
+        if (archive_ && !response.error) {
+            archive_->record(request_key, response.status_code, response.text);
+        }
+    }
+    
     // Helper method to increase backoff time
     void increase_backoff() {
         backoff_seconds_ = std::min(backoff_seconds_ * 2.0, config_.max_backoff_seconds);
     }
-
+    
     const Config& config_;
+    HttpArchive* archive_;
     std::mt19937 rng_;
     double backoff_seconds_;
     std::string usdc_mint_;
@@ -249,7 +275,7 @@ private:
 };
 
 // --- PIMPL forward declarations ---
-JupiterClient::JupiterClient(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+JupiterClient::JupiterClient(const Config& config, HttpArchive* archive) : pImpl_(std::make_unique<Impl>(config, archive)) {}
 JupiterClient::~JupiterClient() = default;
 std::optional<JupiterRoute> JupiterClient::get_quote(const std::string& input_mint, const std::string& output_mint, double amount_in) {
     return pImpl_->get_quote(input_mint, output_mint, amount_in);
@@ -3,6 +3,7 @@
 
 #include "config.hpp"
 #include "types.hpp"
+#include "http_archive.hpp"
 #include <vector>
 #include <memory>
 #include <string>
@@ -10,7 +11,8 @@
 
 class JupiterClient {
 public:
-    explicit JupiterClient(const Config& config);
+    // An archive, when given, captures or replays every quote/price response
+    explicit JupiterClient(const Config& config, HttpArchive* archive = nullptr);
     ~JupiterClient();
     
     // Get a quote for swapping between two tokens
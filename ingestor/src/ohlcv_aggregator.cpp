@@ -3,7 +3,9 @@
 #include <spdlog/spdlog.h>
 #include <algorithm>
 
-OHLCVAggregator::OHLCVAggregator() {
+OHLCVAggregator::OHLCVAggregator(std::vector<int> intervals, bool event_time)
+    : intervals_(std::move(intervals)),
+      event_time_(event_time) {
 }
 
 void OHLCVAggregator::add_price_point(const std::string& pool_id, double price, double volume,
@@ -16,40 +18,26 @@ void OHLCVAggregator::add_price_point(const std::string& pool_id, double price,
     
     PricePoint point{price, volume, timestamp};
     
-    // Process for 5-minute bars
-    auto bar_start_5m = get_bar_start(timestamp, 5);
-    std::string key_5m = make_bar_key(pool_id, 5, bar_start_5m);
-    
-    auto it_5m = active_bars_.find(key_5m);
-    if (it_5m == active_bars_.end()) {
-        BarBuilder builder;
-        builder.pool_id = pool_id;
-        builder.interval_minutes = 5;
-        builder.bar_start = bar_start_5m;
-        builder.add_point(point);
-        active_bars_[key_5m] = std::move(builder);
-    } else {
-        it_5m->second.add_point(point);
-    }
-    
-    // Process for 15-minute bars
-    auto bar_start_15m = get_bar_start(timestamp, 15);
-    std::string key_15m = make_bar_key(pool_id, 15, bar_start_15m);
-    
-    auto it_15m = active_bars_.find(key_15m);
-    if (it_15m == active_bars_.end()) {
-        BarBuilder builder;
-        builder.pool_id = pool_id;
-        builder.interval_minutes = 15;
-        builder.bar_start = bar_start_15m;
-        builder.add_point(point);
-        active_bars_[key_15m] = std::move(builder);
-    } else {
-        it_15m->second.add_point(point);
+    for (int interval : intervals_) {
+        auto bar_start = get_bar_start(timestamp, interval);
+        std::string key = make_bar_key(pool_id, interval, bar_start);
+        
+        auto it = active_bars_.find(key);
+        if (it == active_bars_.end()) {
+            BarBuilder builder;
+            builder.pool_id = pool_id;
+            builder.interval_minutes = interval;
+            builder.bar_start = bar_start;
+            builder.add_point(point);
+            active_bars_[key] = std::move(builder);
+        } else {
+            it->second.add_point(point);
+        }
     }
     
     // Check for completed bars
-    auto now = std::chrono::system_clock::now();
+    watermark_ = std::max(watermark_, timestamp);
+    auto now = event_time_ ? watermark_ : std::chrono::system_clock::now();
     auto it = active_bars_.begin();
     while (it != active_bars_.end()) {
         if (it->second.is_complete(now)) {
@@ -100,6 +88,47 @@ std::optional<OHLCVBar> OHLCVAggregator::get_current_bar(const std::string& pool
     return std::nullopt;
 }
 
+std::vector<OHLCVBar> OHLCVAggregator::get_open_bars() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<OHLCVBar> bars;
+    bars.reserve(active_bars_.size());
+    for (const auto& [key, builder] : active_bars_) {
+        if (builder.has_data) {
+            bars.push_back(builder.to_bar());
+        }
+    }
+    
+    return bars;
+}
+
+void OHLCVAggregator::restore_open_bars(const std::vector<OHLCVBar>& bars) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    for (const auto& bar : bars) {
+        if (bar.open <= 0.0) continue;
+        
+        auto& builder = active_bars_[make_bar_key(bar.pool_id, bar.interval_minutes, bar.timestamp)];
+        if (!builder.has_data) {
+            builder.pool_id = bar.pool_id;
+            builder.interval_minutes = bar.interval_minutes;
+            builder.bar_start = bar.timestamp;
+            builder.open = bar.open;
+            builder.high = bar.high;
+            builder.low = bar.low;
+            builder.close = bar.close;
+            builder.volume = bar.volume;
+            builder.has_data = true;
+        } else {
+            // Points that arrived since the restart are newer, so they keep the close
+            builder.open = bar.open;
+            builder.high = std::max(builder.high, bar.high);
+            builder.low = std::min(builder.low, bar.low);
+            builder.volume += bar.volume;
+        }
+    }
+}
+
 std::vector<OHLCVBar> OHLCVAggregator::flush_all_bars() {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -114,6 +143,7 @@ std::vector<OHLCVBar> OHLCVAggregator::flush_all_bars() {
     
     completed_bars_.clear();
     active_bars_.clear();
+    watermark_ = {};
     
     return all_bars;
 }
@@ -155,18 +185,19 @@ std::chrono::system_clock::time_point OHLCVAggregator::get_bar_start(
 }
 
 void OHLCVAggregator::BarBuilder::add_point(const PricePoint& point) {
-    if (points_.empty()) {
-        open_price_ = point.price;
-        high_price_ = point.price;
-        low_price_ = point.price;
-        volume_ = point.volume;
+    // Running values only, so a bar restored from a snapshot continues where it left off
+    if (!has_data) {
+        open = point.price;
+        high = point.price;
+        low = point.price;
+        volume = point.volume;
         has_data = true;
     } else {
-        high_price_ = std::max(high_price_, point.price);
-        low_price_ = std::min(low_price_, point.price);
-        volume_ += point.volume;
+        high = std::max(high, point.price);
+        low = std::min(low, point.price);
+        volume += point.volume;
     }
-    points_.push_back(point);
+    close = point.price;
 }
 
 bool OHLCVAggregator::BarBuilder::is_complete(const std::chrono::system_clock::time_point& now) const {
@@ -179,10 +210,10 @@ OHLCVBar OHLCVAggregator::BarBuilder::to_bar() const {
     bar.pool_id = pool_id;
     bar.interval_minutes = interval_minutes;
     bar.timestamp = bar_start;
-    bar.open_price = open_price_;
-    bar.high_price = high_price_;
-    bar.low_price = low_price_;
-    bar.close_price = points_.back().price;
-    bar.volume = volume_;
+    bar.open = open;
+    bar.high = high;
+    bar.low = low;
+    bar.close = close;
+    bar.volume = volume;
     return bar;
 }
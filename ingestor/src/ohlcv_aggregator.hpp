@@ -7,7 +7,10 @@
 
 class OHLCVAggregator {
 public:
-    OHLCVAggregator();
+    // In event-time mode bars complete once a point at or past their end has
+    // been seen rather than by the wall clock, so historical data can be
+    // replayed through the same engine (the backfill tool does this)
+    explicit OHLCVAggregator(std::vector<int> intervals = {5, 15}, bool event_time = false);
     
     // Add a price point to the aggregator
     void add_price_point(const std::string& pool_id, double price, double volume, 
@@ -19,6 +22,13 @@ public:
     // Get current incomplete bar for a pool
     std::optional<OHLCVBar> get_current_bar(const std::string& pool_id, int interval_minutes);
     
+    // Copy of every bar still being built, for the warm-start snapshot
+    std::vector<OHLCVBar> get_open_bars();
+    
+    // Resume bars captured by get_open_bars() before a restart; bars already
+    // being built for the same pool and window are merged with them
+    void restore_open_bars(const std::vector<OHLCVBar>& bars);
+    
     // Force completion of current bars (useful for shutdown)
     std::vector<OHLCVBar> flush_all_bars();
     
@@ -54,6 +64,10 @@ private:
     std::chrono::system_clock::time_point get_bar_start(
         const std::chrono::system_clock::time_point& timestamp, int interval_minutes);
     
+    std::vector<int> intervals_;
+    bool event_time_;
+    std::chrono::system_clock::time_point watermark_{};
+    
     std::mutex mutex_;
     std::unordered_map<std::string, BarBuilder> active_bars_;
     std::vector<OHLCVBar> completed_bars_;
@@ -1,440 +1,316 @@
-
 #include "pool_cache.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cmath>
 
-PoolCache::PoolCache(const Config& config)
-    : config_(config) {
+namespace {
+
+// NaN would break the ordering of the TVL index
+double rank_key(double value) {
+    return std::isnan(value) ? 0.0 : value;
 }
 
-PoolCache::PoolCache(size_t max_size, std::chrono::minutes ttl)
-    : max_size_(max_size), ttl_(ttl) {
+// True when every column the pools snapshot writes is unchanged
+bool same_persisted_fields(const PoolInfo& a, const PoolInfo& b) {
+    return a.dex_name == b.dex_name &&
+           a.pool_type == b.pool_type &&
+           a.token_a.address == b.token_a.address &&
+           a.token_b.address == b.token_b.address &&
+           a.reserve_a == b.reserve_a &&
+           a.reserve_b == b.reserve_b &&
+           a.tvl_usd == b.tvl_usd &&
+           a.volume_24h_usd == b.volume_24h_usd &&
+           a.price_token_a_in_b == b.price_token_a_in_b &&
+           a.price_token_b_in_a == b.price_token_b_in_a &&
+           a.price_impact_1pct == b.price_impact_1pct;
 }
 
-PoolCache::PoolCache() = default;
+} // namespace
 
-PoolCache::PoolCache(int max_size, int ttl_minutes)
-    : max_size_(max_size), ttl_(std::chrono::minutes(ttl_minutes)) {}
+PoolCache::PoolCache(const Config& config)
+    : config_(config) {
+}
 
-void PoolCache::put(const std::string& pool_id, const PoolInfo& pool_info) {
+void PoolCache::update_pool(const PoolInfo& pool) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = cache_.find(pool_id);
-    if (it != cache_.end()) {
-        // Update existing entry
-        it->second.pool_info = pool_info;
-        it->second.timestamp = std::chrono::steady_clock::now();
-        
-        // Move to front of LRU list
-        lru_list_.erase(it->second.lru_iterator);
-        lru_list_.push_front(pool_id);
-        it->second.lru_iterator = lru_list_.begin();
-    } else {
-        // Add new entry
-        if (cache_.size() >= max_size_) {
-            evict_lru();
+    // Calculate expiry time
+    auto expiry = std::chrono::steady_clock::now() +
+                  std::chrono::minutes(config_.pool_cache_ttl_minutes);
+    
+    // Update or insert the pool, moving its index entries if the tokens changed
+    auto it = pools_.find(pool.pool_id);
+    if (it != pools_.end()) {
+        auto& entry = it->second;
+        bool changed = !same_persisted_fields(entry.pool, pool);
+        if (entry.pool.token_a.address != pool.token_a.address ||
+            entry.pool.token_b.address != pool.token_b.address) {
+            unindex_pool(entry.pool);
+            index_pool(pool);
+        } else if (rank_key(entry.pool.tvl_usd) != rank_key(pool.tvl_usd)) {
+            unindex_rank(entry.pool);
+            index_rank(pool);
+        }
+        entry.pool = pool;
+        entry.expiry = expiry;
+        if (changed) {
+            mark_dirty(entry, pool.pool_id);
         }
+    } else {
+        auto& entry = pools_.emplace(pool.pool_id, CacheEntry{pool, expiry, 0}).first->second;
+        index_pool(pool);
+        mark_dirty(entry, pool.pool_id);
+    }
+    
+    // Ensure we don't exceed the max cache size
+    if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
+        cleanup_expired_unlocked();
         
-        lru_list_.push_front(pool_id);
-        auto [cache_it, inserted] = cache_.emplace(pool_id, CacheEntry(pool_info));
-        cache_it->second.lru_iterator = lru_list_.begin();
+        // If still too large, remove oldest entries
+        if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
+            evict_oldest_unlocked();
+        }
     }
 }
 
-std::optional<PoolInfo> PoolCache::get(const std::string& pool_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto it = cache_.find(pool_id);
-    if (it == cache_.end()) {
-        miss_count_++;
-        return std::nullopt;
-    }
-    
-    // Check if expired
-    if (is_expired(it->second)) {
-        lru_list_.erase(it->second.lru_iterator);
-        cache_.erase(it);
-        miss_count_++;
-        return std::nullopt;
+void PoolCache::update_pools(const std::vector<PoolInfo>& pools) {
+    for (const auto& pool : pools) {
+        update_pool(pool);
     }
-    
-    // Move to front of LRU list
-    lru_list_.erase(it->second.lru_iterator);
-    lru_list_.push_front(pool_id);
-    it->second.lru_iterator = lru_list_.begin();
-    
-    hit_count_++;
-    return it->second.pool_info;
 }
 
-bool PoolCache::contains(const std::string& pool_id) {
+void PoolCache::restore_pools(const std::vector<PoolInfo>& pools) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = cache_.find(pool_id);
-    if (it == cache_.end()) {
-        return false;
+    auto now = std::chrono::steady_clock::now();
+    auto wall_now = std::chrono::system_clock::now();
+    auto ttl = std::chrono::minutes(config_.pool_cache_ttl_minutes);
+    
+    for (const auto& pool : pools) {
+        auto age = wall_now - pool.last_updated;
+        if (age >= ttl || pools_.count(pool.pool_id) > 0) continue;
+        
+        auto expiry = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(ttl - age);
+        pools_.emplace(pool.pool_id, CacheEntry{pool, expiry, 0});
+        index_pool(pool);
     }
     
-    return !is_expired(it->second);
+    if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
+        cleanup_expired_unlocked();
+        if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
+            evict_oldest_unlocked();
+        }
+    }
 }
 
-void PoolCache::remove(const std::string& pool_id) {
+std::optional<PoolInfo> PoolCache::update_reserve(const std::string& pool_id, bool is_token_a, double reserve) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = cache_.find(pool_id);
-    if (it != cache_.end()) {
-        lru_list_.erase(it->second.lru_iterator);
-        cache_.erase(it);
+    auto it = pools_.find(pool_id);
+    if (it == pools_.end() || it->second.expiry <= std::chrono::steady_clock::now()) {
+        return std::nullopt;
     }
-}
-
-void PoolCache::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    cache_.clear();
-    lru_list_.clear();
-    hit_count_ = 0;
-    miss_count_ = 0;
-    pools_.clear();
-    token_to_pools_.clear();
-}
-
-size_t PoolCache::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return cache_.size();
-}
-
-size_t PoolCache::capacity() const {
-    return max_size_;
-}
-
-double PoolCache::hit_rate() const {
-    std::lock_guard<std::mutex> lock(mutex_);
     
-    size_t total = hit_count_ + miss_count_;
-    if (total == 0) return 0.0;
+    auto& pool = it->second.pool;
+    double& current = is_token_a ? pool.reserve_a : pool.reserve_b;
+    if (current != reserve) {
+        current = reserve;
+        mark_dirty(it->second, pool_id);
+    }
     
-    return static_cast<double>(hit_count_) / total;
+    // Keep the spot price consistent with the reserves we just received
+    if (pool.reserve_a > 0 && pool.reserve_b > 0) {
+        pool.price_token_a_in_b = pool.reserve_b / pool.reserve_a;
+        pool.price_token_b_in_a = pool.reserve_a / pool.reserve_b;
+    }
+    pool.last_updated = std::chrono::system_clock::now();
+    
+    return pool;
 }
 
-std::vector<std::string> PoolCache::get_active_pool_ids() {
+std::optional<PoolInfo> PoolCache::get_pool(const std::string& pool_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::vector<std::string> active_pools;
-    active_pools.reserve(cache_.size());
-    
-    for (const auto& [pool_id, entry] : cache_) {
-        if (!is_expired(entry) && entry.pool_info.is_active) {
-            active_pools.push_back(pool_id);
-        }
+    auto it = pools_.find(pool_id);
+    if (it != pools_.end() && it->second.expiry > std::chrono::steady_clock::now()) {
+        return it->second.pool;
     }
     
-    return active_pools;
+    return std::nullopt;
 }
 
-std::vector<PoolInfo> PoolCache::get_pools_by_tvl_threshold(double min_tvl) {
+std::vector<PoolInfo> PoolCache::get_all_pools() const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::vector<PoolInfo> pools;
-    pools.reserve(cache_.size());
+    std::vector<PoolInfo> result;
+    result.reserve(pools_.size());
     
-    for (const auto& [pool_id, entry] : cache_) {
-        if (!is_expired(entry) && 
-            entry.pool_info.is_active && 
-            entry.pool_info.tvl_usd >= min_tvl) {
-            pools.push_back(entry.pool_info);
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& entry : pools_) {
+        if (entry.second.expiry > now) {
+            result.push_back(entry.second.pool);
         }
     }
     
-    return pools;
+    return result;
 }
 
-void PoolCache::cleanup_expired() {
+std::vector<PoolInfo> PoolCache::get_pools_by_token(const std::string& token_mint) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = cache_.begin();
-    while (it != cache_.end()) {
-        if (is_expired(it->second)) {
-            lru_list_.erase(it->second.lru_iterator);
-            it = cache_.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    auto now = std::chrono::steady_clock::now();
+    std::vector<PoolInfo> result;
     
-    // Remove expired entries
-    for (auto it = pools_.begin(); it != pools_.end();) {
-        if (it->second.expiry <= now) {
-            it = pools_.erase(it);
-        } else {
-            ++it;
-        }
+    auto token_it = token_to_pools_.find(token_mint);
+    if (token_it == token_to_pools_.end()) {
+        return result;
     }
     
-    // Rebuild token_to_pools_ mapping
-    token_to_pools_.clear();
-    for (const auto& entry : pools_) {
-        const auto& pool = entry.second.pool;
-        token_to_pools_[pool.token_a.address].push_back(pool.pool_id);
-        token_to_pools_[pool.token_b.address].push_back(pool.pool_id);
-    }
-}
-
-void PoolCache::evict_lru() {
-    if (lru_list_.empty()) return;
-    
-    std::string lru_key = lru_list_.back();
-    lru_list_.pop_back();
-    cache_.erase(lru_key);
-}
-
-bool PoolCache::is_expired(const CacheEntry& entry) const {
+    result.reserve(token_it->second.size());
     auto now = std::chrono::steady_clock::now();
-    auto age = std::chrono::duration_cast<std::chrono::minutes>(now - entry.timestamp);
-    return age >= ttl_;
-}
-
-bool PoolCache::check_and_update(const PoolInfo& new_pool_info) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = cache_.find(new_pool_info.pool_id);
-
-    // Case 1: Pool is not in the cache (it's new)
-    if (it == cache_.end()) {
-        cache_[new_pool_info.pool_id] = new_pool_info;
-        return true; // It's a new pool, so it has "changed"
-    }
-
-    const auto& old_pool_info = it->second;
-    bool has_changed = false;
-
-    // Case 2: Check for significant changes
-    // Compare is_active status
-    if (old_pool_info.is_active != new_pool_info.is_active) {
-        has_changed = true;
-    }
-
-    // Compare TVL (avoid division by zero)
-    if (old_pool_info.tvl_usd > 1e-9) {
-        double tvl_change = std::abs(new_pool_info.tvl_usd - old_pool_info.tvl_usd) / old_pool_info.tvl_usd;
-        if (tvl_change > TVL_CHANGE_THRESHOLD) {
-            has_changed = true;
-        }
-    } else if (new_pool_info.tvl_usd > 1.0) { // Change from near-zero to something
-        has_changed = true;
-    }
-
-    // Compare Volume (avoid division by zero)
-    if (old_pool_info.volume_24h_usd > 1e-9) {
-        double volume_change = std::abs(new_pool_info.volume_24h_usd - old_pool_info.volume_24h_usd) / old_pool_info.volume_24h_usd;
-        if (volume_change > VOLUME_CHANGE_THRESHOLD) {
-            has_changed = true;
+    for (const auto& pool_id : token_it->second) {
+        auto pool_it = pools_.find(pool_id);
+        if (pool_it != pools_.end() && pool_it->second.expiry > now) {
+            result.push_back(pool_it->second.pool);
         }
-    } else if (new_pool_info.volume_24h_usd > 1.0) { // Change from near-zero to something
-        has_changed = true;
     }
-
-    // If any significant change was detected, update the cache with the new info
-    if (has_changed) {
-        cache_[new_pool_info.pool_id] = new_pool_info;
-    }
-
-    return has_changed;
+    
+    return result;
 }
 
-std::vector<PoolInfo> PoolCache::get_all_pools() {
+std::vector<PoolInfo> PoolCache::get_top_pools_by_tvl(size_t limit,
+                                                  const std::function<bool(const PoolInfo&)>& filter) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<PoolInfo> all_pools;
-    all_pools.reserve(cache_.size());
-    for (const auto& pair : cache_) {
-        all_pools.push_back(pair.second);
-    }
     
     std::vector<PoolInfo> result;
-    result.reserve(pools_.size());
-    
     auto now = std::chrono::steady_clock::now();
-    for (const auto& entry : pools_) {
-        if (entry.second.expiry > now) {
-            result.push_back(entry.second.pool);
-        }
+    
+    // Expired and filtered-out entries are skipped, so a query costs
+    // O(log n + k) plus whatever it has to step over
+    for (auto it = tvl_index_.rbegin(); it != tvl_index_.rend() && result.size() < limit; ++it) {
+        auto pool_it = pools_.find(it->second);
+        if (pool_it == pools_.end() || pool_it->second.expiry <= now) continue;
+        if (filter && !filter(pool_it->second.pool)) continue;
+        
+        result.push_back(pool_it->second.pool);
     }
     
     return result;
 }
 
-void PoolCache::update_cache(const std::vector<PoolInfo>& new_pools) {
+PoolCache::DirtyBatch PoolCache::get_dirty_pools() const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    // Clear existing cache entries
-    cache_.clear();
-    lru_list_.clear();
-    
-    // Add new pools to cache
-    for (const auto& pool : new_pools) {
-        if (cache_.size() >= max_size_) {
-            evict_lru();
-        }
+    DirtyBatch batch;
+    batch.pools.reserve(dirty_.size());
+    batch.versions.reserve(dirty_.size());
+    for (const auto& pool_id : dirty_) {
+        auto it = pools_.find(pool_id);
+        if (it == pools_.end()) continue;
         
-        lru_list_.push_front(pool.pool_id);
-        cache_[pool.pool_id] = CacheEntry(pool);
-        cache_[pool.pool_id].lru_iterator = lru_list_.begin();
+        batch.pools.push_back(it->second.pool);
+        batch.versions.push_back(it->second.version);
     }
+    
+    return batch;
 }
 
-bool PoolCache::check_and_update(const PoolInfo& new_pool_info) {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    auto it = cache_.find(new_pool_info.id);
-
-    if (it == cache_.end()) {
-        // New pool, always update
-        cache_[new_pool_info.id] = {new_pool_info, std::chrono::steady_clock::now()};
-        return true;
-    }
-
-    // Existing pool, check for significant change
-    const auto& cached_pool = it->second.pool;
-    bool changed = (std::abs(cached_pool.price - new_pool_info.price) / cached_pool.price > 0.01) ||
-                   (std::abs(cached_pool.tvl - new_pool_info.tvl) / cached_pool.tvl > 0.05);
-
-    if (changed) {
-        it->second.pool = new_pool_info;
-        it->second.last_updated = std::chrono::steady_clock::now();
+void PoolCache::mark_clean(const DirtyBatch& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    for (size_t i = 0; i < batch.pools.size(); ++i) {
+        const auto& pool_id = batch.pools[i].pool_id;
+        auto it = pools_.find(pool_id);
+        
+        // Changed again while the snapshot was being written
+        if (it != pools_.end() && it->second.version != batch.versions[i]) continue;
+        
+        dirty_.erase(pool_id);
     }
-    return changed;
 }
 
-std::vector<PoolInfo> PoolCache::get_all_pools() {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    std::vector<PoolInfo> pools;
-    pools.reserve(cache_.size());
-    for (const auto& pair : cache_) {
-        pools.push_back(pair.second.pool);
-    }
-    return pools;
+size_t PoolCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pools_.size();
 }
 
 void PoolCache::cleanup_expired() {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
     cleanup_expired_unlocked();
 }
 
-void PoolCache::cleanup_expired_unlocked() {
-    auto now = std::chrono::steady_clock::now();
-    for (auto it = cache_.begin(); it != cache_.end(); ) {
-        if (now - it->second.last_updated > ttl_) {
-            it = cache_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+void PoolCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.clear();
+    token_to_pools_.clear();
+    tvl_index_.clear();
+    dirty_.clear();
 }
 
-void PoolCache::update_pool(const PoolInfo& pool) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Calculate expiry time
-    auto expiry = std::chrono::steady_clock::now() + 
-                  std::chrono::minutes(config_.pool_cache_ttl_minutes);
-    
-    // Update or insert the pool
-    pools_[pool.pool_id] = {pool, expiry};
-    
-    // Update token to pools mapping
-    token_to_pools_[pool.token_a.address].push_back(pool.pool_id);
-    token_to_pools_[pool.token_b.address].push_back(pool.pool_id);
-    
-    // Ensure we don't exceed the max cache size
-    if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
-        cleanup_expired();
+void PoolCache::index_pool(const PoolInfo& pool) {
+    token_to_pools_[pool.token_a.address].insert(pool.pool_id);
+    token_to_pools_[pool.token_b.address].insert(pool.pool_id);
+    index_rank(pool);
+}
+
+void PoolCache::unindex_pool(const PoolInfo& pool) {
+    for (const auto* mint : {&pool.token_a.address, &pool.token_b.address}) {
+        auto it = token_to_pools_.find(*mint);
+        if (it == token_to_pools_.end()) continue;
         
-        // If still too large, remove oldest entries
-        if (pools_.size() > static_cast<size_t>(config_.pool_cache_max_size)) {
-            // Sort entries by expiry time
-            std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> entries;
-            for (const auto& entry : pools_) {
-                entries.emplace_back(entry.first, entry.second.expiry);
-            }
-            
-            // Sort by expiry (oldest first)
-            std::sort(entries.begin(), entries.end(), 
-                [](const auto& a, const auto& b) {
-                    return a.second < b.second;
-                });
-            
-            // Remove oldest entries until we're under the limit
-            size_t to_remove = pools_.size() - config_.pool_cache_max_size;
-            for (size_t i = 0; i < to_remove && i < entries.size(); ++i) {
-                pools_.erase(entries[i].first);
-            }
-            
-            // Rebuild token_to_pools_ mapping
-            token_to_pools_.clear();
-            for (const auto& entry : pools_) {
-                const auto& pool = entry.second.pool;
-                token_to_pools_[pool.token_a.address].push_back(pool.pool_id);
-                token_to_pools_[pool.token_b.address].push_back(pool.pool_id);
-            }
+        it->second.erase(pool.pool_id);
+        if (it->second.empty()) {
+            token_to_pools_.erase(it);
         }
     }
+    unindex_rank(pool);
 }
 
-void PoolCache::update_pools(const std::vector<PoolInfo>& pools) {
-    for (const auto& pool : pools) {
-        update_pool(pool);
-    }
+void PoolCache::index_rank(const PoolInfo& pool) {
+    tvl_index_.emplace(rank_key(pool.tvl_usd), pool.pool_id);
 }
 
-std::optional<PoolInfo> PoolCache::get_pool(const std::string& pool_id) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto it = pools_.find(pool_id);
-    if (it != pools_.end() && it->second.expiry > std::chrono::steady_clock::now()) {
-        return it->second.pool;
-    }
-    
-    return std::nullopt;
+void PoolCache::unindex_rank(const PoolInfo& pool) {
+    tvl_index_.erase({rank_key(pool.tvl_usd), pool.pool_id});
 }
 
-std::vector<PoolInfo> PoolCache::get_all_pools() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    std::vector<PoolInfo> result;
-    result.reserve(pools_.size());
-    
+PoolCache::PoolMap::iterator PoolCache::erase_entry(PoolMap::iterator it) {
+    unindex_pool(it->second.pool);
+    dirty_.erase(it->first);
+    return pools_.erase(it);
+}
+
+void PoolCache::cleanup_expired_unlocked() {
     auto now = std::chrono::steady_clock::now();
-    for (const auto& entry : pools_) {
-        if (entry.second.expiry > now) {
-            result.push_back(entry.second.pool);
+    
+    for (auto it = pools_.begin(); it != pools_.end();) {
+        if (it->second.expiry <= now) {
+            it = erase_entry(it);
+        } else {
+            ++it;
         }
     }
-    
-    return result;
 }
 
-std::vector<PoolInfo> PoolCache::get_pools_by_token(const std::string& token_mint) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+void PoolCache::evict_oldest_unlocked() {
+    size_t to_remove = pools_.size() - static_cast<size_t>(config_.pool_cache_max_size);
     
-    std::vector<PoolInfo> result;
-    
-    auto token_it = token_to_pools_.find(token_mint);
-    if (token_it == token_to_pools_.end()) {
-        return result;
+    // Partition by expiry so only the oldest entries need ordering
+    std::vector<std::pair<std::chrono::steady_clock::time_point, std::string>> entries;
+    entries.reserve(pools_.size());
+    for (const auto& entry : pools_) {
+        entries.emplace_back(entry.second.expiry, entry.first);
     }
+    std::nth_element(entries.begin(), entries.begin() + to_remove, entries.end());
     
-    auto now = std::chrono::steady_clock::now();
-    for (const auto& pool_id : token_it->second) {
-        auto pool_it = pools_.find(pool_id);
-        if (pool_it != pools_.end() && pool_it->second.expiry > now) {
-            result.push_back(pool_it->second.pool);
+    for (size_t i = 0; i < to_remove; ++i) {
+        auto it = pools_.find(entries[i].second);
+        if (it != pools_.end()) {
+            erase_entry(it);
         }
     }
-    
-    return result;
 }
 
-size_t PoolCache::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return pools_.size();
+void PoolCache::mark_dirty(CacheEntry& entry, const std::string& pool_id) {
+    entry.version = next_version_++;
+    dirty_.insert(pool_id);
 }
@@ -4,14 +4,25 @@
 #include "types.hpp"
 #include "config.hpp"
 #include <unordered_map>
+#include <unordered_set>
+#include <set>
 #include <string>
 #include <vector>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <functional>
 
 class PoolCache {
 public:
+    // Pools changed since they were last persisted, with the version each was
+    // read at so a write that races a newer update leaves that pool dirty
+    struct DirtyBatch {
+        std::vector<PoolInfo> pools;
+        std::vector<uint64_t> versions;
+    };
+    
     explicit PoolCache(const Config& config);
     
     // Add or update a pool in the cache
@@ -20,15 +31,34 @@ public:
     // Add or update multiple pools in the cache
     void update_pools(const std::vector<PoolInfo>& pools);
     
+    // Seed the cache from persisted state: pools already present (i.e. fresher)
+    // are kept, the rest expire relative to their last_updated and start clean
+    void restore_pools(const std::vector<PoolInfo>& pools);
+    
+    // Apply an on-chain reserve change to a cached pool. Returns the updated pool
+    // (with price recomputed from the new reserves) or nullopt if the pool is unknown.
+    std::optional<PoolInfo> update_reserve(const std::string& pool_id, bool is_token_a, double reserve);
+    
     // Get a pool by ID
     std::optional<PoolInfo> get_pool(const std::string& pool_id) const;
     
     // Get all pools in the cache
     std::vector<PoolInfo> get_all_pools() const;
     
-    // Get pools for a specific token
+    // Get pools for a specific token (served from the token index)
     std::vector<PoolInfo> get_pools_by_token(const std::string& token_mint) const;
     
+    // The `limit` deepest pools that pass the filter (all pools when it is
+    // empty), highest TVL first (served from the TVL index)
+    std::vector<PoolInfo> get_top_pools_by_tvl(size_t limit,
+                                               const std::function<bool(const PoolInfo&)>& filter = {}) const;
+    
+    // Pools whose persisted fields changed since the last mark_clean
+    DirtyBatch get_dirty_pools() const;
+    
+    // Mark a batch as persisted after its transaction committed
+    void mark_clean(const DirtyBatch& batch);
+    
     // Get the number of pools in the cache
     size_t size() const;
     
@@ -42,10 +72,30 @@ private:
     struct CacheEntry {
         PoolInfo pool;
         std::chrono::steady_clock::time_point expiry;
+        uint64_t version = 0;
     };
     
+    using PoolMap = std::unordered_map<std::string, CacheEntry>;
+    
+    // Ascending (tvl, pool_id); queries walk it from the top
+    using RankIndex = std::set<std::pair<double, std::string>>;
+    
+    // The token and TVL indexes are kept in step with pools_ on every insert,
+    // update and erase
+    void index_pool(const PoolInfo& pool);
+    void unindex_pool(const PoolInfo& pool);
+    void index_rank(const PoolInfo& pool);
+    void unindex_rank(const PoolInfo& pool);
+    PoolMap::iterator erase_entry(PoolMap::iterator it);
+    void cleanup_expired_unlocked();
+    void evict_oldest_unlocked();
+    void mark_dirty(CacheEntry& entry, const std::string& pool_id);
+    
     const Config& config_;
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, CacheEntry> pools_;
-    std::unordered_map<std::string, std::vector<std::string>> token_to_pools_;
+    PoolMap pools_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> token_to_pools_;
+    RankIndex tvl_index_;
+    std::unordered_set<std::string> dirty_;
+    uint64_t next_version_ = 1;
 };
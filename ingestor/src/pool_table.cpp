@@ -0,0 +1,65 @@
+#include "pool_table.hpp"
+#include "simd.hpp"
+
+namespace {
+
+using namespace simd;
+
+// Indices i with a[i] >= min_a and b[i] >= min_b. NaN never passes, matching
+// the scalar comparison.
+PoolTable::Selection select_both_at_least(const double* a, double min_a,
+                                          const double* b, double min_b, size_t n) {
+    PoolTable::Selection selection;
+    selection.reserve(n);
+    
+    const vd va = vset(min_a);
+    const vd vb = vset(min_b);
+    size_t full = n - n % kLanes;
+    for (size_t i = 0; i < full; i += kLanes) {
+        int mask = vmovemask(vand(vcmp_ge(vload(a + i), va), vcmp_ge(vload(b + i), vb)));
+        if (mask == 0) continue;
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            if (mask & (1 << lane)) {
+                selection.push_back(static_cast<uint32_t>(i + lane));
+            }
+        }
+    }
+    
+    for (size_t i = full; i < n; ++i) {
+        if (a[i] >= min_a && b[i] >= min_b) {
+            selection.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    
+    return selection;
+}
+
+} // namespace
+
+void PoolTable::reserve(size_t n) {
+    tvl_usd_.reserve(n);
+    volume_24h_usd_.reserve(n);
+    rows_.reserve(n);
+}
+
+void PoolTable::append(PoolInfo pool) {
+    tvl_usd_.push_back(pool.tvl_usd);
+    volume_24h_usd_.push_back(pool.volume_24h_usd);
+    rows_.push_back(std::move(pool));
+}
+
+PoolTable::Selection PoolTable::select_liquid(double min_tvl, double min_volume) const {
+    return select_both_at_least(tvl_usd_.data(), min_tvl,
+                                volume_24h_usd_.data(), min_volume, rows_.size());
+}
+
+std::vector<PoolInfo> PoolTable::take(const Selection& selection) {
+    std::vector<PoolInfo> pools;
+    pools.reserve(selection.size());
+    for (uint32_t index : selection) {
+        pools.push_back(std::move(rows_[index]));
+    }
+    
+    *this = PoolTable();
+    return pools;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstdint>
+#include <vector>
+
+// Columnar view of a pool set. The fields the filters scan are kept as
+// contiguous columns so threshold passes run over SIMD lanes and return
+// selection vectors (row indices) rather than copies; the full PoolInfo rows
+// are only touched when the selected pools are taken out of the table.
+class PoolTable {
+public:
+    using Selection = std::vector<uint32_t>;
+    
+    void reserve(size_t n);
+    void append(PoolInfo pool);
+    size_t size() const { return rows_.size(); }
+    
+    // Rows whose TVL and 24h volume both reach their thresholds
+    Selection select_liquid(double min_tvl, double min_volume) const;
+    
+    // Move the selected rows out in selection order; the table is cleared
+    std::vector<PoolInfo> take(const Selection& selection);
+
+private:
+    std::vector<double> tvl_usd_;
+    std::vector<double> volume_24h_usd_;
+    std::vector<PoolInfo> rows_;
+};
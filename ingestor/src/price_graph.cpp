@@ -0,0 +1,269 @@
+#include "price_graph.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+const std::string kUsdcMint = "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v";
+const std::string kUsdtMint = "Es9vMFrzaCERmJfrF4H2FYD4KCoNkY11McCe8BenwNYB";
+
+// Paths longer than this are not worth trusting for a price
+constexpr int kMaxHops = 4;
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+} // namespace
+
+class PriceGraph::Impl {
+public:
+    explicit Impl(const Config& config) : config_(config) {}
+    
+    void rebuild(const std::vector<PoolInfo>& pools) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        nodes_.clear();
+        edges_.clear();
+        node_index_.clear();
+        edge_index_.clear();
+        
+        for (const auto& pool : pools) {
+            if (pool.price_token_a_in_b <= 0.0 || pool.token_a.address == pool.token_b.address) continue;
+            
+            size_t a = node_for(pool.token_a.address);
+            size_t b = node_for(pool.token_b.address);
+            size_t e = edges_.size();
+            edges_.push_back(Edge{pool.pool_id, a, b, pool.price_token_a_in_b, pool.tvl_usd});
+            edge_index_.emplace(pool.pool_id, e);
+            nodes_[a].edges.push_back(e);
+            nodes_[b].edges.push_back(e);
+        }
+        
+        propagate();
+        
+        for (size_t n = 0; n < nodes_.size(); ++n) {
+            refresh_deviation(n);
+        }
+        
+        spdlog::debug("Price graph rebuilt: {} mints, {} pools, {} priced",
+                     nodes_.size(), edges_.size(), priced_count_unlocked());
+    }
+    
+    void update_pool(const PoolInfo& pool) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = edge_index_.find(pool.pool_id);
+        if (it == edge_index_.end() || pool.price_token_a_in_b <= 0.0) {
+            return;
+        }
+        
+        auto& edge = edges_[it->second];
+        edge.price_a_in_b = pool.price_token_a_in_b;
+        edge.liquidity_usd = pool.tvl_usd;
+        
+        // The tree shape is chosen by liquidity, which a reserve tick barely moves,
+        // so only the subtree hanging off this pool needs its prices rescaled
+        std::vector<size_t> touched;
+        for (size_t child : {edge.a, edge.b}) {
+            auto& node = nodes_[child];
+            if (node.parent_edge != it->second) continue;
+            
+            size_t parent = edge.other(child);
+            double repriced = implied_price(child, it->second, nodes_[parent].price_usd);
+            if (node.price_usd > 0.0 && repriced > 0.0) {
+                rescale_subtree(child, repriced / node.price_usd, touched);
+            }
+        }
+        
+        touched.push_back(edge.a);
+        touched.push_back(edge.b);
+        for (size_t n : touched) {
+            refresh_deviation(n);
+        }
+    }
+    
+    std::optional<TokenPrice> get_price(const std::string& mint) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = node_index_.find(mint);
+        if (it == node_index_.end()) {
+            return std::nullopt;
+        }
+        
+        const auto& node = nodes_[it->second];
+        if (node.price_usd <= 0.0) {
+            return std::nullopt;
+        }
+        
+        TokenPrice price;
+        price.price_usd = node.price_usd;
+        price.hops = node.hops;
+        price.liquidity_usd = node.bottleneck_usd;
+        price.deviation_pct = node.deviation_pct;
+        if (node.parent_edge != kNone) {
+            price.via_pool = edges_[node.parent_edge].pool_id;
+        }
+        return price;
+    }
+    
+    size_t priced_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return priced_count_unlocked();
+    }
+
+private:
+    struct Edge {
+        std::string pool_id;
+        size_t a;
+        size_t b;
+        double price_a_in_b;   // 1 A = price_a_in_b B
+        double liquidity_usd;
+        
+        size_t other(size_t n) const { return n == a ? b : a; }
+    };
+    
+    struct Node {
+        std::string mint;
+        std::vector<size_t> edges;
+        double price_usd = 0.0;
+        int hops = 0;
+        double bottleneck_usd = 0.0;
+        double deviation_pct = 0.0;
+        size_t parent_edge = kNone;
+        std::vector<size_t> children;
+    };
+    
+    size_t node_for(const std::string& mint) {
+        auto [it, inserted] = node_index_.emplace(mint, nodes_.size());
+        if (inserted) {
+            Node node;
+            node.mint = mint;
+            nodes_.push_back(std::move(node));
+        }
+        return it->second;
+    }
+    
+    // Price of `node` given the USD price of the other end of `edge`
+    double implied_price(size_t node, size_t edge_id, double neighbour_price) const {
+        const auto& edge = edges_[edge_id];
+        return node == edge.a ? neighbour_price * edge.price_a_in_b
+                              : neighbour_price / edge.price_a_in_b;
+    }
+    
+    // Widest-path search: each mint is priced through the path whose thinnest
+    // pool is deepest, preferring fewer hops on ties
+    void propagate() {
+        struct Label {
+            double bottleneck;
+            int hops;
+            size_t node;
+            size_t edge;
+            size_t parent;
+            
+            bool operator<(const Label& other) const {
+                if (bottleneck != other.bottleneck) return bottleneck < other.bottleneck;
+                return hops > other.hops;
+            }
+        };
+        
+        std::priority_queue<Label> queue;
+        for (const auto* anchor : {&kUsdcMint, &kUsdtMint}) {
+            auto it = node_index_.find(*anchor);
+            if (it != node_index_.end()) {
+                queue.push(Label{std::numeric_limits<double>::infinity(), 0, it->second, kNone, kNone});
+            }
+        }
+        
+        std::vector<bool> settled(nodes_.size(), false);
+        while (!queue.empty()) {
+            Label label = queue.top();
+            queue.pop();
+            if (settled[label.node]) continue;
+            settled[label.node] = true;
+            
+            auto& node = nodes_[label.node];
+            node.hops = label.hops;
+            node.bottleneck_usd = std::isinf(label.bottleneck) ? 0.0 : label.bottleneck;
+            node.parent_edge = label.edge;
+            if (label.parent == kNone) {
+                node.price_usd = 1.0;
+            } else {
+                node.price_usd = implied_price(label.node, label.edge, nodes_[label.parent].price_usd);
+                nodes_[label.parent].children.push_back(label.node);
+            }
+            
+            if (label.hops >= kMaxHops) continue;
+            for (size_t e : node.edges) {
+                size_t next = edges_[e].other(label.node);
+                if (settled[next]) continue;
+                queue.push(Label{std::min(label.bottleneck, edges_[e].liquidity_usd),
+                                 label.hops + 1, next, e, label.node});
+            }
+        }
+    }
+    
+    void rescale_subtree(size_t root, double factor, std::vector<size_t>& touched) {
+        std::vector<size_t> stack{root};
+        while (!stack.empty()) {
+            size_t n = stack.back();
+            stack.pop_back();
+            nodes_[n].price_usd *= factor;
+            touched.push_back(n);
+            stack.insert(stack.end(), nodes_[n].children.begin(), nodes_[n].children.end());
+        }
+    }
+    
+    // Compare the tree price with the price implied by the deepest other pool
+    // into an already priced neighbour; a large gap means a stale or thin route
+    void refresh_deviation(size_t n) {
+        auto& node = nodes_[n];
+        node.deviation_pct = 0.0;
+        if (node.price_usd <= 0.0 || node.parent_edge == kNone) {
+            return;
+        }
+        
+        double best_liquidity = config_.min_tvl_threshold;
+        double alternative = 0.0;
+        for (size_t e : node.edges) {
+            const auto& edge = edges_[e];
+            const auto& neighbour = nodes_[edge.other(n)];
+            
+            // Skip the path we were priced through and mints priced through us
+            if (e == node.parent_edge || neighbour.parent_edge == e) continue;
+            
+            double neighbour_price = neighbour.price_usd;
+            if (neighbour_price <= 0.0 || edge.liquidity_usd < best_liquidity) continue;
+            
+            best_liquidity = edge.liquidity_usd;
+            alternative = implied_price(n, e, neighbour_price);
+        }
+        
+        if (alternative > 0.0) {
+            node.deviation_pct = std::abs(alternative - node.price_usd) / node.price_usd * 100.0;
+        }
+    }
+    
+    size_t priced_count_unlocked() const {
+        return static_cast<size_t>(std::count_if(nodes_.begin(), nodes_.end(),
+            [](const Node& node) { return node.price_usd > 0.0; }));
+    }
+    
+    const Config& config_;
+    mutable std::mutex mutex_;
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    std::unordered_map<std::string, size_t> node_index_;
+    std::unordered_map<std::string, size_t> edge_index_;
+};
+
+// --- PIMPL forward declarations ---
+PriceGraph::PriceGraph(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+PriceGraph::~PriceGraph() = default;
+void PriceGraph::rebuild(const std::vector<PoolInfo>& pools) { pImpl_->rebuild(pools); }
+void PriceGraph::update_pool(const PoolInfo& pool) { pImpl_->update_pool(pool); }
+std::optional<TokenPrice> PriceGraph::get_price(const std::string& mint) const { return pImpl_->get_price(mint); }
+size_t PriceGraph::priced_count() const { return pImpl_->priced_count(); }
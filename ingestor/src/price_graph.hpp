@@ -0,0 +1,43 @@
+#pragma once
+
+#include "config.hpp"
+#include "types.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct TokenPrice {
+    double price_usd = 0.0;
+    int hops = 0;                 // pools between the mint and a USD anchor
+    double liquidity_usd = 0.0;   // TVL of the thinnest pool on the path
+    double deviation_pct = 0.0;   // disagreement with the best alternative path
+    std::string via_pool;         // first pool on the path
+};
+
+// Token graph built from the ingested pools: mints are nodes, pools are edges
+// weighted by their spot price and TVL. USD prices are propagated outwards from
+// USDC/USDT (and SOL, priced off them) along the deepest path, so every mint we
+// track is priced locally instead of through one HTTP quote per mint.
+class PriceGraph {
+public:
+    explicit PriceGraph(const Config& config);
+    ~PriceGraph();
+    
+    // Rebuild the graph and the pricing tree from a full pool set
+    void rebuild(const std::vector<PoolInfo>& pools);
+    
+    // Apply a price change of a known pool. Only the mints priced through it
+    // are repriced; pools not yet in the graph wait for the next rebuild.
+    void update_pool(const PoolInfo& pool);
+    
+    // Best-path USD price and route estimate for a mint
+    std::optional<TokenPrice> get_price(const std::string& mint) const;
+    
+    // Number of mints that currently have a USD price
+    size_t priced_count() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
@@ -1,5 +1,17 @@
 #include "rate_limiter.hpp"
 #include <algorithm>
+#include <mutex>
+#include <thread>
+
+RateLimiter::Bucket::Bucket(int requests_per_second, int burst_capacity) {
+    configure(requests_per_second, burst_capacity);
+}
+
+void RateLimiter::Bucket::configure(int requests_per_second, int burst_capacity) {
+    int64_t interval = 1'000'000'000LL / std::max(1, requests_per_second);
+    emission_interval_ns.store(interval, std::memory_order_relaxed);
+    burst_tolerance_ns.store(interval * (std::max(1, burst_capacity) - 1), std::memory_order_relaxed);
+}
 
 RateLimiter::RateLimiter(int requests_per_second, int burst_capacity)
     : default_requests_per_second_(requests_per_second),
@@ -7,77 +19,106 @@ RateLimiter::RateLimiter(int requests_per_second, int burst_capacity)
 }
 
 bool RateLimiter::allow_request(const std::string& endpoint) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t now = now_ns();
+    return reserve(bucket_for(endpoint), now, now) >= 0;
+}
+
+bool RateLimiter::acquire(const std::string& endpoint, std::chrono::steady_clock::time_point deadline) {
+    int64_t now = now_ns();
+    int64_t latest = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
     
-    auto it = buckets_.find(endpoint);
-    if (it == buckets_.end()) {
-        // Create new bucket for this endpoint
-        buckets_.emplace(endpoint, TokenBucket(default_burst_capacity_, default_requests_per_second_));
-        it = buckets_.find(endpoint);
+    int64_t ready_at = reserve(bucket_for(endpoint), now, latest);
+    if (ready_at < 0) {
+        return false;
     }
     
-    refill_bucket(it->second);
-    
-    if (it->second.tokens >= 1.0) {
-        it->second.tokens -= 1.0;
-        return true;
+    // The slot is already ours, so a single timed sleep is enough
+    if (ready_at > now) {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(ready_at)));
     }
-    
-    return false;
+    return true;
 }
 
 std::chrono::milliseconds RateLimiter::time_until_allowed(const std::string& endpoint) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto it = buckets_.find(endpoint);
-    if (it == buckets_.end()) {
+    Bucket* bucket = find_bucket(endpoint);
+    if (!bucket) {
         return std::chrono::milliseconds(0);
     }
     
-    refill_bucket(it->second);
-    
-    if (it->second.tokens >= 1.0) {
+    int64_t now = now_ns();
+    int64_t allowed_at = bucket->tat_ns.load(std::memory_order_acquire)
+                       - bucket->burst_tolerance_ns.load(std::memory_order_relaxed);
+    if (allowed_at <= now) {
         return std::chrono::milliseconds(0);
     }
     
-    // Calculate time needed to accumulate 1 token
-    double tokens_needed = 1.0 - it->second.tokens;
-    double seconds_needed = tokens_needed / it->second.refill_rate;
-    
-    return std::chrono::milliseconds(static_cast<int>(seconds_needed * 1000));
+    // Round up so callers that sleep this long are guaranteed a slot
+    return std::chrono::ceil<std::chrono::milliseconds>(std::chrono::nanoseconds(allowed_at - now));
 }
 
 void RateLimiter::set_endpoint_limit(const std::string& endpoint, int requests_per_second, int burst_capacity) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(registry_mutex_);
     
     auto it = buckets_.find(endpoint);
     if (it != buckets_.end()) {
-        it->second.capacity = burst_capacity;
-        it->second.refill_rate = static_cast<double>(requests_per_second);
-        it->second.tokens = std::min(it->second.tokens, static_cast<double>(burst_capacity));
+        it->second->configure(requests_per_second, burst_capacity);
     } else {
-        buckets_.emplace(endpoint, TokenBucket(burst_capacity, requests_per_second));
+        buckets_.emplace(endpoint, std::make_unique<Bucket>(requests_per_second, burst_capacity));
     }
 }
 
 void RateLimiter::reset_limits() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(registry_mutex_);
     
     for (auto& [endpoint, bucket] : buckets_) {
-        bucket.tokens = bucket.capacity;
-        bucket.last_refill = std::chrono::steady_clock::now();
+        bucket->tat_ns.store(0, std::memory_order_release);
     }
 }
 
-void RateLimiter::refill_bucket(TokenBucket& bucket) {
-    auto now = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(now - bucket.last_refill).count();
-    
-    bucket.tokens += duration * bucket.refill_rate;
+RateLimiter::Bucket& RateLimiter::bucket_for(const std::string& endpoint) {
+    if (Bucket* bucket = find_bucket(endpoint)) {
+        return *bucket;
+    }
     
-    if (bucket.tokens > bucket.capacity) {
-        bucket.tokens = bucket.capacity;
+    // First request for an unregistered endpoint: create it with the defaults
+    std::unique_lock<std::shared_mutex> lock(registry_mutex_);
+    auto [it, inserted] = buckets_.try_emplace(endpoint, nullptr);
+    if (inserted) {
+        it->second = std::make_unique<Bucket>(default_requests_per_second_, default_burst_capacity_);
     }
+    return *it->second;
+}
+
+RateLimiter::Bucket* RateLimiter::find_bucket(const std::string& endpoint) const {
+    std::shared_lock<std::shared_mutex> lock(registry_mutex_);
+    
+    // Buckets are never erased, so the pointer stays valid after unlocking
+    auto it = buckets_.find(endpoint);
+    return it != buckets_.end() ? it->second.get() : nullptr;
+}
+
+int64_t RateLimiter::reserve(Bucket& bucket, int64_t now, int64_t latest) {
+    int64_t interval = bucket.emission_interval_ns.load(std::memory_order_relaxed);
+    int64_t tolerance = bucket.burst_tolerance_ns.load(std::memory_order_relaxed);
     
-    bucket.last_refill = now;
-}
\ No newline at end of file
+    int64_t tat = bucket.tat_ns.load(std::memory_order_acquire);
+    while (true) {
+        // A request conforms once now >= tat - tolerance
+        int64_t ready_at = std::max(now, tat - tolerance);
+        if (ready_at > latest) {
+            return -1;
+        }
+        
+        int64_t new_tat = std::max(tat, now) + interval;
+        if (bucket.tat_ns.compare_exchange_weak(tat, new_tat,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+            return ready_at;
+        }
+    }
+}
+
+int64_t RateLimiter::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -1,10 +1,15 @@
-
 #pragma once
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
+// Per-endpoint rate limiting using the generic cell rate algorithm (GCRA).
+// Each bucket is a single atomic "theoretical arrival time" updated with a
+// CAS loop, so concurrent fetchers never serialize on a lock. Buckets are
+// registered once; after that, lookups only take a shared lock.
 class RateLimiter {
 public:
     RateLimiter(int requests_per_second = 10, int burst_capacity = 20);
@@ -12,6 +17,10 @@ public:
     // Check if request is allowed for given endpoint
     bool allow_request(const std::string& endpoint = "default");
     
+    // Reserve the next slot for the endpoint and sleep until it arrives.
+    // Returns false without consuming a slot if it would arrive after deadline.
+    bool acquire(const std::string& endpoint, std::chrono::steady_clock::time_point deadline);
+    
     // Get time until next request is allowed
     std::chrono::milliseconds time_until_allowed(const std::string& endpoint = "default");
     
@@ -22,21 +31,26 @@ public:
     void reset_limits();
 
 private:
-    struct TokenBucket {
-        double tokens;
-        int capacity;
-        double refill_rate; // tokens per second
-        std::chrono::steady_clock::time_point last_refill;
+    struct Bucket {
+        std::atomic<int64_t> tat_ns{0};                // theoretical arrival time
+        std::atomic<int64_t> emission_interval_ns{0};  // 1 / rate
+        std::atomic<int64_t> burst_tolerance_ns{0};    // (burst - 1) * interval
         
-        TokenBucket(int cap, double rate) 
-            : tokens(cap), capacity(cap), refill_rate(rate), 
-              last_refill(std::chrono::steady_clock::now()) {}
+        Bucket(int requests_per_second, int burst_capacity);
+        void configure(int requests_per_second, int burst_capacity);
     };
     
-    void refill_bucket(TokenBucket& bucket);
+    Bucket& bucket_for(const std::string& endpoint);
+    Bucket* find_bucket(const std::string& endpoint) const;
+    
+    // Claims a slot if it becomes available no later than `latest`; returns
+    // the time the slot becomes available, or -1 if it would be too late
+    static int64_t reserve(Bucket& bucket, int64_t now, int64_t latest);
+    
+    static int64_t now_ns();
     
-    std::mutex mutex_;
-    std::unordered_map<std::string, TokenBucket> buckets_;
+    mutable std::shared_mutex registry_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<Bucket>> buckets_;
     int default_requests_per_second_;
     int default_burst_capacity_;
 };
@@ -5,6 +5,7 @@
 #include <nlohmann/json.hpp>
 #include <thread>
 #include <chrono>
+#include <iterator>
 #include "util.hpp"
 
 class RedisPublisher::Impl {
@@ -68,6 +69,22 @@ public:
             if (update.price_impact_1pct) {
                 json_update["price_impact_1pct"] = *update.price_impact_1pct;
             }
+            if (update.price_impact_1k) {
+                json_update["price_impact_1k"] = *update.price_impact_1k;
+            }
+            if (update.price_impact_10k) {
+                json_update["price_impact_10k"] = *update.price_impact_10k;
+            }
+            if (update.price_usd) {
+                json_update["price_usd"] = *update.price_usd;
+            }
+            if (update.route_hops && update.route_deviation_pct) {
+                json_update["route"] = {
+                    {"ok", true},
+                    {"hops", *update.route_hops},
+                    {"deviation_pct", *update.route_deviation_pct}
+                };
+            }
             
             // Publish to Redis stream
             std::unordered_map<std::string, std::string> fields;
@@ -124,6 +141,22 @@ public:
                 if (update.price_impact_1pct) {
                     json_update["price_impact_1pct"] = *update.price_impact_1pct;
                 }
+                if (update.price_impact_1k) {
+                    json_update["price_impact_1k"] = *update.price_impact_1k;
+                }
+                if (update.price_impact_10k) {
+                    json_update["price_impact_10k"] = *update.price_impact_10k;
+                }
+                if (update.price_usd) {
+                    json_update["price_usd"] = *update.price_usd;
+                }
+                if (update.route_hops && update.route_deviation_pct) {
+                    json_update["route"] = {
+                        {"ok", true},
+                        {"hops", *update.route_hops},
+                        {"deviation_pct", *update.route_deviation_pct}
+                    };
+                }
                 
                 // Add to pipeline
                 std::unordered_map<std::string, std::string> fields;
@@ -144,6 +177,28 @@ public:
         }
     }
     
+    std::unordered_set<std::string> fetch_watched_mints() {
+        std::unordered_set<std::string> mints;
+        if (!redis_) {
+            return mints;
+        }
+        
+        try {
+            // Members are scored by the expiry of their watch mark (ms since epoch)
+            double now_ms = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            redis_->zrangebyscore(config_.redis_watchlist_key,
+                                  sw::redis::LeftBoundedInterval<double>(now_ms, sw::redis::BoundType::OPEN),
+                                  std::inserter(mints, mints.end()));
+            redis_->zremrangebyscore(config_.redis_watchlist_key,
+                                     sw::redis::RightBoundedInterval<double>(now_ms, sw::redis::BoundType::OPEN));
+        } catch (const std::exception& e) {
+            spdlog::warn("Failed to read watchlist from Redis: {}", e.what());
+        }
+        
+        return mints;
+    }
+    
     bool check_health() {
         if (!redis_) {
             return false;
@@ -169,4 +224,5 @@ RedisPublisher::RedisPublisher(const Config& config) : pImpl_(std::make_unique<I
 RedisPublisher::~RedisPublisher() = default;
 bool RedisPublisher::publish_market_update(const MarketUpdate& update) { return pImpl_->publish_market_update(update); }
 bool RedisPublisher::publish_market_updates(const std::vector<MarketUpdate>& updates) { return pImpl_->publish_market_updates(updates); }
+std::unordered_set<std::string> RedisPublisher::fetch_watched_mints() { return pImpl_->fetch_watched_mints(); }
 bool RedisPublisher::check_health() { return pImpl_->check_health(); }
@@ -5,6 +5,7 @@
 #include "types.hpp"
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 class RedisPublisher {
@@ -18,6 +19,9 @@ public:
     // Publish multiple market updates to Redis
     bool publish_market_updates(const std::vector<MarketUpdate>& updates);
     
+    // Mints analytics has marked as watched and whose mark hasn't expired
+    std::unordered_set<std::string> fetch_watched_mints();
+    
     // Check Redis connection health
     bool check_health();
 
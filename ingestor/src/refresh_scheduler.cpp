@@ -0,0 +1,202 @@
+#include "refresh_scheduler.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+constexpr double kVolatilityAlpha = 0.3;
+constexpr double kVolatilityUnit = 0.002;   // 0.2% per sqrt(minute) adds one priority point
+constexpr double kMaxVolatilityScore = 4.0;
+constexpr double kWatchedScore = 4.0;
+
+} // namespace
+
+class RefreshScheduler::Impl {
+public:
+    explicit Impl(const Config& config) : config_(config) {}
+    
+    void sync(const std::vector<PoolInfo>& pools, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        std::unordered_map<std::string, Entry> next;
+        next.reserve(pools.size());
+        for (const auto& pool : pools) {
+            auto it = entries_.find(pool.pool_id);
+            Entry entry = it != entries_.end() ? std::move(it->second) : Entry{};
+            update_entry(entry, pool, now);
+            next.emplace(pool.pool_id, std::move(entry));
+        }
+        entries_ = std::move(next);
+        
+        // The bulk fetch refreshed everything, so rebuild the queue from scratch
+        queue_ = {};
+        size_t hot = 0;
+        for (auto& [pool_id, entry] : entries_) {
+            if (is_hot(entry)) {
+                push(pool_id, entry, now + entry.interval);
+                hot++;
+            } else {
+                entry.next_due = Clock::time_point::max();
+            }
+        }
+        
+        spdlog::debug("Refresh scheduler tracking {} pools, {} hot", entries_.size(), hot);
+    }
+    
+    void observe(const PoolInfo& pool, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = entries_.find(pool.pool_id);
+        if (it == entries_.end()) {
+            return;
+        }
+        
+        update_entry(it->second, pool, now);
+        
+        // Only requeue when the pool became due sooner than already planned
+        if (is_hot(it->second) && now + it->second.interval < it->second.next_due) {
+            push(pool.pool_id, it->second, now + it->second.interval);
+        }
+    }
+    
+    void set_watched_mints(std::unordered_set<std::string> mints) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        watched_mints_ = std::move(mints);
+    }
+    
+    std::vector<std::string> due(Clock::time_point now, size_t max_pools) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        std::vector<std::string> result;
+        while (!queue_.empty() && result.size() < max_pools && queue_.top().due <= now) {
+            QueueItem item = queue_.top();
+            queue_.pop();
+            
+            auto it = entries_.find(item.pool_id);
+            if (it == entries_.end() || it->second.generation != item.generation) {
+                continue;  // superseded by a later push() or the pool is gone
+            }
+            
+            result.push_back(item.pool_id);
+            
+            // Reschedule now so a failed refresh is simply retried next interval
+            if (is_hot(it->second)) {
+                push(item.pool_id, it->second, now + it->second.interval);
+            } else {
+                it->second.next_due = Clock::time_point::max();
+            }
+        }
+        return result;
+    }
+    
+    void retry(const std::vector<std::string>& pool_ids, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& pool_id : pool_ids) {
+            auto it = entries_.find(pool_id);
+            if (it != entries_.end() && is_hot(it->second)) {
+                push(pool_id, it->second, now);
+            }
+        }
+    }
+    
+    bool is_hot(const std::string& pool_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(pool_id);
+        return it != entries_.end() && is_hot(it->second);
+    }
+    
+    size_t hot_pool_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<size_t>(std::count_if(entries_.begin(), entries_.end(),
+            [this](const auto& item) { return is_hot(item.second); }));
+    }
+
+private:
+    struct Entry {
+        double tvl_usd = 0.0;
+        double last_price = 0.0;
+        Clock::time_point last_refresh{};
+        double volatility = 0.0;  // EWMA of |log return| per sqrt(minute)
+        bool watched = false;
+        Clock::duration interval{};
+        Clock::time_point next_due{};
+        uint64_t generation = 0;
+    };
+    
+    struct QueueItem {
+        Clock::time_point due;
+        std::string pool_id;
+        uint64_t generation;
+        
+        bool operator>(const QueueItem& other) const { return due > other.due; }
+    };
+    
+    void update_entry(Entry& entry, const PoolInfo& pool, Clock::time_point now) {
+        double price = pool.price_token_a_in_b;
+        if (entry.last_price > 0.0 && price > 0.0 && now > entry.last_refresh) {
+            double minutes = std::chrono::duration<double, std::ratio<60>>(now - entry.last_refresh).count();
+            double move = std::abs(std::log(price / entry.last_price)) / std::sqrt(std::max(minutes, 1.0 / 60.0));
+            entry.volatility = kVolatilityAlpha * move + (1.0 - kVolatilityAlpha) * entry.volatility;
+        }
+        if (price > 0.0) {
+            entry.last_price = price;
+        }
+        
+        entry.tvl_usd = pool.tvl_usd;
+        entry.last_refresh = now;
+        entry.watched = watched_mints_.count(pool.token_a.address) > 0 ||
+                        watched_mints_.count(pool.token_b.address) > 0;
+        entry.interval = interval_for(entry);
+    }
+    
+    // Every priority point divides the bulk interval: a pool scoring 0 waits for
+    // the next bulk fetch, one scoring 9 is refreshed ten times as often.
+    Clock::duration interval_for(const Entry& entry) const {
+        double score = 0.0;
+        if (config_.min_tvl_threshold > 0.0 && entry.tvl_usd > config_.min_tvl_threshold) {
+            score += std::log10(entry.tvl_usd / config_.min_tvl_threshold);
+        }
+        score += std::min(kMaxVolatilityScore, entry.volatility / kVolatilityUnit);
+        if (entry.watched) {
+            score += kWatchedScore;
+        }
+        
+        auto bulk = std::chrono::duration<double>(config_.global_tick_seconds);
+        auto fastest = std::chrono::duration<double>(config_.reserve_refresh_seconds);
+        auto interval = std::max(fastest, bulk / (1.0 + score));
+        return std::chrono::duration_cast<Clock::duration>(interval);
+    }
+    
+    // Pools that would gain less than one extra refresh per bulk tick are left to it
+    bool is_hot(const Entry& entry) const {
+        return config_.reserve_refresh_seconds > 0 &&
+               entry.interval * 2 <= std::chrono::seconds(config_.global_tick_seconds);
+    }
+    
+    void push(const std::string& pool_id, Entry& entry, Clock::time_point due) {
+        entry.generation++;
+        entry.next_due = due;
+        queue_.push(QueueItem{due, pool_id, entry.generation});
+    }
+    
+    const Config& config_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::unordered_set<std::string> watched_mints_;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue_;
+};
+
+// --- PIMPL forward declarations ---
+RefreshScheduler::RefreshScheduler(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+RefreshScheduler::~RefreshScheduler() = default;
+void RefreshScheduler::sync(const std::vector<PoolInfo>& pools, Clock::time_point now) { pImpl_->sync(pools, now); }
+void RefreshScheduler::observe(const PoolInfo& pool, Clock::time_point now) { pImpl_->observe(pool, now); }
+void RefreshScheduler::set_watched_mints(std::unordered_set<std::string> mints) { pImpl_->set_watched_mints(std::move(mints)); }
+std::vector<std::string> RefreshScheduler::due(Clock::time_point now, size_t max_pools) { return pImpl_->due(now, max_pools); }
+void RefreshScheduler::retry(const std::vector<std::string>& pool_ids, Clock::time_point now) { pImpl_->retry(pool_ids, now); }
+bool RefreshScheduler::is_hot(const std::string& pool_id) const { return pImpl_->is_hot(pool_id); }
+size_t RefreshScheduler::hot_pool_count() const { return pImpl_->hot_pool_count(); }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "config.hpp"
+#include "types.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Gives each pool its own refresh interval instead of refreshing everything
+// once per global tick. Deep, volatile pools and pools analytics is watching
+// are refreshed every few seconds through targeted reads; everything else
+// is left to the bulk DEX list fetched on the global tick (and the service's
+// slower on-chain sweep of cold pools).
+class RefreshScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    explicit RefreshScheduler(const Config& config);
+    ~RefreshScheduler();
+    
+    // Replace the tracked set with the pools returned by a bulk fetch.
+    // Every pool in the set counts as freshly refreshed.
+    void sync(const std::vector<PoolInfo>& pools, Clock::time_point now);
+    
+    // Record a targeted refresh of a single pool
+    void observe(const PoolInfo& pool, Clock::time_point now);
+    
+    // Mints analytics is currently watching; their pools get top priority
+    void set_watched_mints(std::unordered_set<std::string> mints);
+    
+    // Pop up to max_pools pools whose refresh is due, most overdue first.
+    // Returned pools are rescheduled one interval ahead.
+    std::vector<std::string> due(Clock::time_point now, size_t max_pools);
+    
+    // Put pools back at the front of the queue (e.g. when the fetch budget ran out)
+    void retry(const std::vector<std::string>& pool_ids, Clock::time_point now);
+    
+    // Whether the pool is refreshed faster than the global tick
+    bool is_hot(const std::string& pool_id) const;
+    
+    // Number of pools refreshed faster than the global tick
+    size_t hot_pool_count() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
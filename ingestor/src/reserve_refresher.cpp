@@ -0,0 +1,219 @@
+#include "reserve_refresher.hpp"
+#include "util.hpp"
+#include "rpc_endpoint_manager.hpp"
+#include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <zstd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+// SPL token account layout: mint (32) | owner (32) | amount (u64 LE) | ...
+constexpr size_t kTokenAmountOffset = 64;
+
+struct VaultRef {
+    const PoolInfo* pool;
+    bool is_token_a;
+};
+
+// Frames written by a streaming compressor don't record their content size,
+// so they have to be decoded chunk by chunk
+std::string zstd_decompress_stream(const std::string& compressed) {
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+    if (!dctx) {
+        throw std::runtime_error("Unable to allocate zstd decompression context");
+    }
+    
+    std::string decompressed;
+    std::string chunk(ZSTD_DStreamOutSize(), '\0');
+    ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+    
+    for (;;) {
+        ZSTD_outBuffer output{chunk.data(), chunk.size(), 0};
+        size_t result = ZSTD_decompressStream(dctx.get(), &output, &input);
+        if (ZSTD_isError(result)) {
+            throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(result));
+        }
+        decompressed.append(chunk.data(), output.pos);
+        
+        if (result == 0) {
+            break; // Frame complete
+        }
+        if (input.pos == input.size && output.pos < output.size) {
+            throw std::runtime_error("Truncated zstd frame");
+        }
+    }
+    
+    return decompressed;
+}
+
+std::string zstd_decompress(const std::string& compressed) {
+    unsigned long long size = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR) {
+        throw std::runtime_error("Invalid zstd frame");
+    }
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN) {
+        return zstd_decompress_stream(compressed);
+    }
+    
+    std::string decompressed(static_cast<size_t>(size), '\0');
+    size_t result = ZSTD_decompress(decompressed.data(), decompressed.size(),
+                                    compressed.data(), compressed.size());
+    if (ZSTD_isError(result)) {
+        throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(result));
+    }
+    
+    decompressed.resize(result);
+    return decompressed;
+}
+
+std::optional<uint64_t> decode_token_amount(const nlohmann::json& account) {
+    if (!account.is_object() || !account.contains("data")) {
+        return std::nullopt;
+    }
+    
+    // data: ["<payload>", "base64+zstd"]
+    const auto& data = account["data"];
+    if (!data.is_array() || data.size() != 2) {
+        return std::nullopt;
+    }
+    
+    std::string raw = util::base64_decode(data[0].get<std::string>());
+    if (data[1].get<std::string>() == "base64+zstd") {
+        raw = zstd_decompress(raw);
+    }
+    
+    if (raw.size() < kTokenAmountOffset + sizeof(uint64_t)) {
+        return std::nullopt;
+    }
+    
+    // Solana is little-endian, as are all the hosts we deploy on
+    uint64_t amount = 0;
+    std::memcpy(&amount, raw.data() + kTokenAmountOffset, sizeof(amount));
+    return amount;
+}
+
+} // namespace
+
+class ReserveRefresher::Impl {
+public:
+    explicit Impl(const Config& config)
+        : config_(config), endpoints_(config.solana_rpc_urls) {}
+    
+    std::vector<ReserveUpdate> refresh(const std::vector<PoolInfo>& pools) {
+        std::vector<ReserveUpdate> updates;
+        if (config_.solana_rpc_urls.empty()) {
+            return updates;
+        }
+        
+        // Flatten pools into an ordered list of vault accounts
+        std::vector<std::string> accounts;
+        std::vector<VaultRef> refs;
+        accounts.reserve(pools.size() * 2);
+        refs.reserve(pools.size() * 2);
+        for (const auto& pool : pools) {
+            if (pool.vault_a.empty() || pool.vault_b.empty()) continue;
+            accounts.push_back(pool.vault_a);
+            refs.push_back({&pool, true});
+            accounts.push_back(pool.vault_b);
+            refs.push_back({&pool, false});
+        }
+        
+        size_t calls = 0;
+        for (size_t offset = 0; offset < accounts.size(); offset += kMaxAccountsPerCall) {
+            size_t count = std::min(kMaxAccountsPerCall, accounts.size() - offset);
+            std::vector<std::string> batch(accounts.begin() + offset, accounts.begin() + offset + count);
+            
+            auto values = fetch_batch(batch);
+            ++calls;
+            if (!values) continue;
+            
+            for (size_t i = 0; i < count && i < values->size(); ++i) {
+                try {
+                    auto amount = decode_token_amount((*values)[i]);
+                    if (!amount) continue;
+                    
+                    const auto& ref = refs[offset + i];
+                    int decimals = ref.is_token_a ? ref.pool->token_a.decimals : ref.pool->token_b.decimals;
+                    double reserve = static_cast<double>(*amount) / std::pow(10.0, decimals);
+                    double current = ref.is_token_a ? ref.pool->reserve_a : ref.pool->reserve_b;
+                    
+                    if (reserve != current) {
+                        updates.push_back({ref.pool->pool_id, ref.is_token_a, reserve});
+                    }
+                } catch (const std::exception& e) {
+                    spdlog::warn("Error decoding vault account {}: {}", batch[i], e.what());
+                }
+            }
+        }
+        
+        spdlog::debug("Reserve refresh: {} vaults in {} calls, {} changed",
+                     accounts.size(), calls, updates.size());
+        return updates;
+    }
+
+private:
+    std::optional<nlohmann::json> fetch_batch(const std::vector<std::string>& batch) {
+        nlohmann::json request = {
+            {"jsonrpc", "2.0"},
+            {"id", 1},
+            {"method", "getMultipleAccounts"},
+            {"params", {batch, {{"encoding", "base64+zstd"}, {"commitment", "confirmed"}}}}
+        };
+        
+        // Freshness is the whole point of this path, so hedge slow endpoints
+        auto response_text = endpoints_.execute_hedged([body = request.dump()](const std::string& url) {
+            return post_rpc(url, body);
+        });
+        if (!response_text) {
+            spdlog::warn("getMultipleAccounts failed on all RPC endpoints");
+            return std::nullopt;
+        }
+        
+        try {
+            auto json_res = nlohmann::json::parse(*response_text);
+            return json_res["result"]["value"];
+        } catch (const std::exception& e) {
+            spdlog::warn("Malformed getMultipleAccounts response: {}", e.what());
+            return std::nullopt;
+        }
+    }
+    
+    static std::optional<std::string> post_rpc(const std::string& url, const std::string& body) {
+        auto response = cpr::Post(
+            cpr::Url{url},
+            cpr::Header{{"Content-Type", "application/json"}, {"User-Agent", "SoulScout/1.1"}},
+            cpr::Body{body},
+            cpr::Timeout{10000}
+        );
+        
+        if (response.error || response.status_code != 200) {
+            spdlog::debug("getMultipleAccounts failed on {}: status {}, {}",
+                         url, response.status_code, response.error.message);
+            return std::nullopt;
+        }
+        
+        // JSON-RPC errors come back as 200; treat them as endpoint failures
+        auto json_res = nlohmann::json::parse(response.text, nullptr, false);
+        if (json_res.is_discarded() || !json_res.contains("result") || !json_res["result"].contains("value")) {
+            spdlog::debug("getMultipleAccounts error from {}: {}", url, response.text.substr(0, 200));
+            return std::nullopt;
+        }
+        
+        return response.text;
+    }
+    
+    const Config& config_;
+    RpcEndpointManager endpoints_;
+};
+
+// --- PIMPL forward declarations ---
+ReserveRefresher::ReserveRefresher(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+ReserveRefresher::~ReserveRefresher() = default;
+std::vector<ReserveUpdate> ReserveRefresher::refresh(const std::vector<PoolInfo>& pools) { return pImpl_->refresh(pools); }
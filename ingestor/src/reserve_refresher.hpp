@@ -0,0 +1,34 @@
+#pragma once
+
+#include "config.hpp"
+#include "types.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ReserveUpdate {
+    std::string pool_id;
+    bool is_token_a = true;
+    double reserve = 0.0;  // UI units (raw amount / 10^decimals)
+};
+
+// Reads pool vault balances straight from Solana RPC with batched
+// getMultipleAccounts calls (base64+zstd encoded SPL token accounts).
+// Much cheaper than re-downloading the DEX pool lists, so it can run at a
+// faster cadence than the global tick.
+class ReserveRefresher {
+public:
+    // Solana caps getMultipleAccounts at 100 keys per call
+    static constexpr size_t kMaxAccountsPerCall = 100;
+    
+    explicit ReserveRefresher(const Config& config);
+    ~ReserveRefresher();
+    
+    // Fetch the vault balances of the given pools and return the reserves
+    // that differ from the values currently held in the PoolInfo
+    std::vector<ReserveUpdate> refresh(const std::vector<PoolInfo>& pools);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Routes Solana RPC requests to the healthiest endpoint. Each endpoint keeps an
+// EWMA of its latency and error rate; requests go to the best-scoring one and
+// fall through the ranking on failure. Latency-critical calls can be hedged:
+// if the primary hasn't answered within its p95 latency, the same request is
+// sent to the runner-up and stands in for the primary if that fails. Hedges
+// are timed by one long-lived thread and sent from a small fixed set of
+// workers, so hedging starts no threads per call.
+class RpcEndpointManager {
+public:
+    // Performs one request against the given URL, returning the response body
+    // on success or nullopt on any failure. A losing hedge may still be running
+    // after execute_hedged() returns, so the function must own its captures.
+    using RequestFunc = std::function<std::optional<std::string>(const std::string& url)>;
+    
+    explicit RpcEndpointManager(const std::vector<std::string>& urls,
+                                double ewma_alpha = 0.2,
+                                double max_hedge_ratio = 0.1);
+    
+    // Waits for any hedged request still in flight
+    ~RpcEndpointManager();
+
+    
+    // Send to the best endpoint, falling back through the ranking on failure
+    std::optional<std::string> execute(const RequestFunc& request) const;
+    
+    // Send to the best endpoint on the calling thread and hedge to the second
+    // best after the primary's p95 latency; returns the primary's response, or
+    // the hedge's if the primary fails
+    std::optional<std::string> execute_hedged(const RequestFunc& request) const;
+    
+    // Feed externally observed outcomes (e.g. from WebSocket connections)
+    void record_success(const std::string& url, std::chrono::milliseconds latency);
+    void record_failure(const std::string& url);
+    
+    // Endpoints ordered best first
+    std::vector<std::string> ranked_urls() const;
+    
+    size_t size() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
@@ -2,16 +2,46 @@
 #include <spdlog/spdlog.h>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include "state_snapshot.hpp"
 #include "util.hpp"
 
+namespace {
+
+// How often the scheduler is polled for due pools, and how many it may hand out at once
+constexpr auto kHotRefreshPollInterval = std::chrono::seconds(1);
+constexpr size_t kMaxHotPoolsPerPoll = 500;
+
+// pool_fetch_limiter_ bucket for targeted per-pool DEX API fetches
+const std::string kPoolFetchEndpoint = "pool_by_id";
+
+// Graph prices further than this from Jupiter's quote are logged as suspect
+constexpr double kMaxPriceCheckDeviationPct = 2.0;
+
+} // namespace
+
 Service::Service(const Config& config)
     : config_(config),
-      dex_client_(config),
-      jupiter_client_(config),
+      http_archive_(config),
+      dex_client_(config, &pool_cache_, &http_archive_),
+      jupiter_client_(config, &http_archive_),
       db_manager_(config),
       redis_publisher_(config),
       pool_cache_(config),
-      last_db_save_(std::chrono::steady_clock::now()) {
+      price_graph_(config),
+      shard_coordinator_(config),
+      account_subscriber_(config, [this](const std::string& pool_id, bool is_token_a, double reserve) {
+          on_reserve_update(pool_id, is_token_a, reserve);
+      }),
+      reserve_refresher_(config),
+      refresh_scheduler_(config),
+      pool_fetch_limiter_(config.pool_fetch_rps, config.pool_fetch_rps),
+      last_db_save_(std::chrono::steady_clock::now()),
+      next_hot_refresh_(std::chrono::steady_clock::now()),
+      next_cold_sweep_(std::chrono::steady_clock::now() + std::chrono::seconds(config.cold_refresh_seconds)),
+      next_price_check_(std::chrono::steady_clock::now() + std::chrono::minutes(config.price_check_minutes)) {
     
     // Initialize database schema
     if (!db_manager_.initialize_schema()) {
@@ -19,30 +49,93 @@ Service::Service(const Config& config)
     }
 }
 
+Service::~Service() {
+    stop();
+}
+
 void Service::run() {
     running_ = true;
     spdlog::info("Ingestor service started. Global tick every {} seconds.", config_.global_tick_seconds);
-
+    
+    if (config_.account_subscribe_enabled) {
+        account_subscriber_.start();
+    }
+    
+    // Claim our shards before the first tick decides what to publish
+    shard_coordinator_.start();
+    
+    // Serve persisted state while the first full fetch is still in flight
+    if (config_.warm_start_enabled) {
+        warm_start_ = std::async(std::launch::async, [this]() { warm_start(); });
+    }
+    
     while (running_) {
+        uint64_t replayed_before = http_archive_.replayed_count();
         try {
             tick();
         } catch (const std::exception& e) {
             spdlog::error("Error in service tick: {}", e.what());
         }
         
-        auto wake_up_time = std::chrono::steady_clock::now() + std::chrono::seconds(config_.global_tick_seconds);
+        // A replay tick that got no recorded response at all has reached the
+        // end of the archive; going on would only spin on empty ticks
+        if (http_archive_.mode() == HttpArchive::Mode::Replay &&
+            http_archive_.replayed_count() == replayed_before) {
+            spdlog::info("Replay archive exhausted after {} responses, stopping", replayed_before);
+            stop();
+            break;
+        }
+        
+        auto wake_up_time = std::chrono::steady_clock::now() + tick_interval();
         while (running_ && std::chrono::steady_clock::now() < wake_up_time) {
+            // Hot pools are refreshed individually between the bulk DEX ticks
+            if (config_.reserve_refresh_seconds > 0 &&
+                std::chrono::steady_clock::now() >= next_hot_refresh_) {
+                try {
+                    refresh_hot_pools();
+                } catch (const std::exception& e) {
+                    spdlog::error("Error in hot pool refresh: {}", e.what());
+                }
+                next_hot_refresh_ = std::chrono::steady_clock::now() + kHotRefreshPollInterval;
+            }
+            // Everything else is still read on-chain, just at a slower cadence
+            if (config_.cold_refresh_seconds > 0 &&
+                std::chrono::steady_clock::now() >= next_cold_sweep_) {
+                try {
+                    sweep_cold_pools();
+                } catch (const std::exception& e) {
+                    spdlog::error("Error in cold pool sweep: {}", e.what());
+                }
+                next_cold_sweep_ = std::chrono::steady_clock::now() + std::chrono::seconds(config_.cold_refresh_seconds);
+            }
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
     spdlog::info("Ingestor service run loop finished.");
 }
 
+std::chrono::steady_clock::duration Service::tick_interval() const {
+    std::chrono::duration<double> interval = std::chrono::seconds(config_.global_tick_seconds);
+    
+    // Replays run on the recorded timeline, so ticks speed up with it
+    if (http_archive_.mode() == HttpArchive::Mode::Replay) {
+        interval = config_.http_replay_speed > 0.0 ? interval / config_.http_replay_speed
+                                                   : std::chrono::duration<double>::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+}
+
 void Service::stop() {
     if (running_.exchange(false)) {
         spdlog::info("Stopping ingestor service...");
-        // Here you could add logic to flush any pending data, e.g., save final snapshot
-        db_manager_.save_pool_snapshot(pool_cache_.get_all_pools());
+        account_subscriber_.stop();
+        shard_coordinator_.stop();
+        // Flush whatever changed since the last periodic snapshot
+        auto dirty = pool_cache_.get_dirty_pools();
+        if (db_manager_.save_pool_snapshot(dirty.pools)) {
+            pool_cache_.mark_clean(dirty);
+        }
+        write_state_snapshot_file();
         spdlog::info("Final snapshot saved.");
     }
 }
@@ -51,26 +144,55 @@ void Service::tick() {
     auto start_time = std::chrono::steady_clock::now();
     spdlog::debug("Starting service tick");
     
-    // Fetch pools from DEXs
+    // Fetch pools from DEXs; already filtered by TVL and volume thresholds
     auto pools = dex_client_.fetch_pools();
-    spdlog::info("Fetched {} pools from DEXs", pools.size());
+    spdlog::info("{} pools meet threshold criteria", pools.size());
     
-    // Filter pools based on TVL and volume thresholds
-    auto filtered_pools = std::vector<PoolInfo>();
-    for (const auto& pool : pools) {
-        if (pool.tvl_usd >= config_.min_tvl_threshold || 
-            pool.volume_24h_usd >= config_.min_volume_threshold) {
-            filtered_pools.push_back(pool);
+    // Fresh data must land after the warm-start state, never underneath it
+    if (warm_start_.valid()) {
+        try {
+            warm_start_.get();
+        } catch (const std::exception& e) {
+            spdlog::warn("Warm start failed: {}", e.what());
         }
     }
-    spdlog::info("{} pools meet threshold criteria", filtered_pools.size());
+    
+    // Reprice every mint from the full pool set, including other shards' pools
+    price_graph_.rebuild(pools);
+    
+    // Everything below only handles the pools this instance's shards own
+    if (shard_coordinator_.enabled()) {
+        pools.erase(std::remove_if(pools.begin(), pools.end(),
+            [this](const PoolInfo& pool) { return !shard_coordinator_.owns(pool.pool_id); }),
+            pools.end());
+        spdlog::info("{} pools owned by {} shards of this instance", pools.size(), shard_coordinator_.owned_shard_count());
+    }
     
     // Update pool cache
-    pool_cache_.update_pools(filtered_pools);
+    pool_cache_.update_pools(pools);
+    
+    // Re-prioritise per-pool refreshes around what analytics is watching
+    refresh_scheduler_.set_watched_mints(redis_publisher_.fetch_watched_mints());
+    refresh_scheduler_.sync(pools, std::chrono::steady_clock::now());
+    spdlog::info("{} pools scheduled for fast refresh", refresh_scheduler_.hot_pool_count());
+    
+    // Keep the on-chain subscriptions pointed at the most liquid pools
+    if (config_.account_subscribe_enabled) {
+        account_subscriber_.refresh_subscriptions(pool_cache_.get_top_pools_by_tvl(
+            static_cast<size_t>(config_.account_subscribe_top_n), [this](const PoolInfo& pool) {
+                return !pool.vault_a.empty() && !pool.vault_b.empty() && shard_coordinator_.owns(pool.pool_id);
+            }));
+    }
+    
+    // Feed tick prices into the OHLCV engine
+    auto now = std::chrono::system_clock::now();
+    for (const auto& pool : pools) {
+        ohlcv_aggregator_.add_price_point(pool.pool_id, pool.price_token_a_in_b, 0.0, now);
+    }
     
     // Create market updates and publish to Redis
     std::vector<MarketUpdate> updates;
-    for (const auto& pool : filtered_pools) {
+    for (const auto& pool : pools) {
         updates.push_back(create_market_update(pool));
     }
     
@@ -78,9 +200,17 @@ void Service::tick() {
         redis_publisher_.publish_market_updates(updates);
     }
     
+    // Persist bars that closed since the last tick
+    save_completed_bars();
+    
     // Save snapshot to database if needed
     save_snapshot_if_needed();
     
+    if (config_.price_check_minutes > 0 && std::chrono::steady_clock::now() >= next_price_check_) {
+        check_prices_against_jupiter();
+        next_price_check_ = std::chrono::steady_clock::now() + std::chrono::minutes(config_.price_check_minutes);
+    }
+    
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
     spdlog::info("Service tick completed in {} ms", duration);
@@ -91,14 +221,274 @@ void Service::save_snapshot_if_needed() {
     auto elapsed = std::chrono::duration_cast<std::chrono::minutes>(now - last_db_save_).count();
     
     if (elapsed >= config_.snapshot_persist_minutes) {
-        spdlog::info("Saving pool snapshot to database");
-        auto pools = pool_cache_.get_all_pools();
-        if (db_manager_.save_pool_snapshot(pools)) {
+        // Only rows that changed since the last committed snapshot are written
+        auto dirty = pool_cache_.get_dirty_pools();
+        spdlog::info("Saving pool snapshot to database ({} of {} pools changed)",
+                    dirty.pools.size(), pool_cache_.size());
+        if (db_manager_.save_pool_snapshot(dirty.pools)) {
+            pool_cache_.mark_clean(dirty);
             last_db_save_ = now;
         }
+        write_state_snapshot_file();
     }
 }
 
+void Service::warm_start() {
+    auto start_time = std::chrono::steady_clock::now();
+    auto max_age = std::chrono::minutes(config_.pool_cache_ttl_minutes);
+    
+    // The local file also carries the open bars; Postgres only has the pools
+    std::vector<PoolInfo> pools;
+    std::vector<OHLCVBar> open_bars;
+    std::string source = "database";
+    
+    std::optional<StateSnapshot> snapshot;
+    if (!config_.warm_start_file.empty()) {
+        snapshot = read_state_snapshot(config_.warm_start_file);
+    }
+    if (snapshot && std::chrono::system_clock::now() - snapshot->written_at < max_age) {
+        pools = std::move(snapshot->pools);
+        open_bars = std::move(snapshot->open_bars);
+        source = config_.warm_start_file;
+    } else {
+        pools = db_manager_.load_recent_pools(max_age);
+    }
+    
+    if (shard_coordinator_.enabled()) {
+        pools.erase(std::remove_if(pools.begin(), pools.end(),
+            [this](const PoolInfo& pool) { return !shard_coordinator_.owns(pool.pool_id); }),
+            pools.end());
+        open_bars.erase(std::remove_if(open_bars.begin(), open_bars.end(),
+            [this](const OHLCVBar& bar) { return !shard_coordinator_.owns(bar.pool_id); }),
+            open_bars.end());
+    }
+    
+    if (pools.empty()) {
+        spdlog::info("Warm start: nothing recent to restore from {}", source);
+        return;
+    }
+    
+    pool_cache_.restore_pools(pools);
+    ohlcv_aggregator_.restore_open_bars(open_bars);
+    price_graph_.rebuild(pool_cache_.get_all_pools());
+    
+    // Restored reserves are as old as the pool's last refresh, and analytics
+    // files prices into its history by update time, so they keep that stamp
+    // rather than passing for a fresh tick
+    std::vector<MarketUpdate> updates;
+    updates.reserve(pools.size());
+    for (const auto& pool : pools) {
+        auto update = create_market_update(pool);
+        update.timestamp = pool.last_updated;
+        updates.push_back(std::move(update));
+    }
+    redis_publisher_.publish_market_updates(updates);
+    
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    spdlog::info("Warm start from {}: {} pools and {} open bars restored in {} ms",
+                source, pools.size(), open_bars.size(), duration);
+}
+
+void Service::write_state_snapshot_file() {
+    if (config_.warm_start_file.empty()) {
+        return;
+    }
+    
+    StateSnapshot snapshot;
+    snapshot.written_at = std::chrono::system_clock::now();
+    snapshot.pools = pool_cache_.get_all_pools();
+    snapshot.open_bars = ohlcv_aggregator_.get_open_bars();
+    write_state_snapshot(config_.warm_start_file, snapshot);
+}
+
+void Service::save_completed_bars() {
+    auto bars = ohlcv_aggregator_.get_completed_bars(5);
+    auto bars_15m = ohlcv_aggregator_.get_completed_bars(15);
+    bars.insert(bars.end(), bars_15m.begin(), bars_15m.end());
+    
+    if (!bars.empty()) {
+        db_manager_.save_ohlcv_bars(bars);
+    }
+}
+
+void Service::refresh_hot_pools() {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    auto due = refresh_scheduler_.due(start_time, kMaxHotPoolsPerPoll);
+    if (due.empty()) {
+        return;
+    }
+    
+    // Pools with known vaults are read on-chain in batches; the rest need a DEX API call each
+    std::vector<PoolInfo> on_chain;
+    std::vector<std::string> by_id;
+    for (const auto& pool_id : due) {
+        if (!shard_coordinator_.owns(pool_id)) continue;
+        
+        auto pool = pool_cache_.get_pool(pool_id);
+        if (!pool) continue;
+        if (!pool->vault_a.empty() && !pool->vault_b.empty()) {
+            on_chain.push_back(std::move(*pool));
+        } else {
+            by_id.push_back(pool_id);
+        }
+    }
+    
+    auto changed = apply_reserve_updates(reserve_refresher_.refresh(on_chain));
+    
+    // Targeted fetches wait for API budget, but no longer than the next poll
+    auto fetch_deadline = start_time + kHotRefreshPollInterval;
+    for (size_t i = 0; i < by_id.size(); ++i) {
+        if (!pool_fetch_limiter_.acquire(kPoolFetchEndpoint, fetch_deadline)) {
+            // Out of API budget: these go to the front of the queue for the next poll
+            refresh_scheduler_.retry(std::vector<std::string>(by_id.begin() + i, by_id.end()), start_time);
+            break;
+        }
+        
+        auto pool = dex_client_.fetch_pool_by_id(by_id[i]);
+        if (pool) {
+            pool_cache_.update_pool(*pool);
+            price_graph_.update_pool(*pool);
+            ohlcv_aggregator_.add_price_point(pool->pool_id, pool->price_token_a_in_b, 0.0, std::chrono::system_clock::now());
+            changed[pool->pool_id] = std::move(*pool);
+        }
+    }
+    
+    // Feed the fresh prices back so volatile pools keep their short intervals
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& pool : on_chain) {
+        auto it = changed.find(pool.pool_id);
+        refresh_scheduler_.observe(it != changed.end() ? it->second : pool, now);
+    }
+    for (const auto& pool_id : by_id) {
+        auto it = changed.find(pool_id);
+        if (it != changed.end()) {
+            refresh_scheduler_.observe(it->second, now);
+        }
+    }
+    
+    publish_changed_pools(changed);
+    
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    spdlog::debug("Hot refresh of {} due pools updated {} in {} ms", due.size(), changed.size(), duration);
+}
+
+void Service::sweep_cold_pools() {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    // Hot pools are already read on their own schedule
+    std::vector<PoolInfo> cold;
+    for (auto& pool : pool_cache_.get_all_pools()) {
+        if (pool.vault_a.empty() || pool.vault_b.empty()) continue;
+        if (!shard_coordinator_.owns(pool.pool_id) || refresh_scheduler_.is_hot(pool.pool_id)) continue;
+        cold.push_back(std::move(pool));
+    }
+    if (cold.empty()) {
+        return;
+    }
+    
+    auto changed = apply_reserve_updates(reserve_refresher_.refresh(cold));
+    
+    // A cold pool that started moving is promoted by the scheduler
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& [pool_id, pool] : changed) {
+        refresh_scheduler_.observe(pool, now);
+    }
+    
+    publish_changed_pools(changed);
+    
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time).count();
+    spdlog::debug("Cold sweep of {} pools updated {} in {} ms", cold.size(), changed.size(), duration);
+}
+
+std::unordered_map<std::string, PoolInfo> Service::apply_reserve_updates(const std::vector<ReserveUpdate>& reserve_updates) {
+    // One entry per changed pool, even when both vaults moved
+    std::unordered_map<std::string, PoolInfo> changed;
+    for (const auto& reserve_update : reserve_updates) {
+        auto pool = apply_reserve_update(reserve_update.pool_id, reserve_update.is_token_a, reserve_update.reserve);
+        if (pool) {
+            changed[pool->pool_id] = std::move(*pool);
+        }
+    }
+    return changed;
+}
+
+void Service::publish_changed_pools(const std::unordered_map<std::string, PoolInfo>& changed) {
+    std::vector<MarketUpdate> updates;
+    updates.reserve(changed.size());
+    for (const auto& [pool_id, pool] : changed) {
+        updates.push_back(create_market_update(pool));
+    }
+    
+    if (!updates.empty()) {
+        redis_publisher_.publish_market_updates(updates);
+    }
+}
+
+void Service::check_prices_against_jupiter() {
+    auto pools = pool_cache_.get_all_pools();
+    if (pools.empty()) {
+        return;
+    }
+    
+    // Walk the pool set round-robin so every mint gets checked eventually
+    size_t checked = 0;
+    size_t suspect = 0;
+    for (int i = 0; i < config_.price_check_samples; ++i) {
+        const auto& mint = pools[price_check_cursor_++ % pools.size()].token_a.address;
+        
+        auto graph_price = price_graph_.get_price(mint);
+        if (!graph_price) continue;
+        
+        auto jupiter_price = jupiter_client_.get_usd_price(mint);
+        if (!jupiter_price || *jupiter_price <= 0.0) continue;
+        
+        ++checked;
+        double deviation_pct = std::abs(graph_price->price_usd - *jupiter_price) / *jupiter_price * 100.0;
+        if (deviation_pct > kMaxPriceCheckDeviationPct) {
+            ++suspect;
+            spdlog::warn("Graph price for {} is {:.2f}% off Jupiter ({} vs {}, {} hops via {})",
+                        mint, deviation_pct, graph_price->price_usd, *jupiter_price,
+                        graph_price->hops, graph_price->via_pool);
+        }
+    }
+    
+    spdlog::info("Price sanity check: {} mints quoted, {} suspect, {} priced from the graph",
+                checked, suspect, price_graph_.priced_count());
+}
+
+std::optional<PoolInfo> Service::apply_reserve_update(const std::string& pool_id, bool is_token_a, double reserve) {
+    // A shard handed to another instance stops publishing here before the next tick drops its pools
+    if (!shard_coordinator_.owns(pool_id)) {
+        return std::nullopt;
+    }
+    
+    // PoolCache and OHLCVAggregator are safe to call concurrently with tick()
+    auto pool = pool_cache_.update_reserve(pool_id, is_token_a, reserve);
+    if (!pool || pool->price_token_a_in_b <= 0.0) {
+        return std::nullopt;
+    }
+    
+    price_graph_.update_pool(*pool);
+    
+    ohlcv_aggregator_.add_price_point(pool->pool_id, pool->price_token_a_in_b, 0.0, pool->last_updated);
+    return pool;
+}
+
+void Service::on_reserve_update(const std::string& pool_id, bool is_token_a, double reserve) {
+    // Runs on the subscriber's thread
+    auto pool = apply_reserve_update(pool_id, is_token_a, reserve);
+    if (!pool) {
+        return;
+    }
+    
+    redis_publisher_.publish_market_update(create_market_update(*pool));
+    
+    spdlog::debug("On-chain reserve update for pool {} (side {}): {}", pool_id, is_token_a ? "A" : "B", reserve);
+}
+
 MarketUpdate Service::create_market_update(const PoolInfo& pool_info) {
     MarketUpdate update;
     
@@ -115,6 +505,15 @@ MarketUpdate Service::create_market_update(const PoolInfo& pool_info) {
     update.tvl_usd = pool_info.tvl_usd;
     update.volume_24h_usd = pool_info.volume_24h_usd;
     update.price_impact_1pct = pool_info.price_impact_1pct;
+    update.price_impact_1k = pool_info.price_impact_1k;
+    update.price_impact_10k = pool_info.price_impact_10k;
+    
+    // USD price and route estimate come from the local token graph
+    if (auto price = price_graph_.get_price(pool_info.token_a.address)) {
+        update.price_usd = price->price_usd;
+        update.route_hops = price->hops;
+        update.route_deviation_pct = price->deviation_pct;
+    }
     
     // Set timestamp to current time
     update.timestamp = std::chrono::system_clock::now();
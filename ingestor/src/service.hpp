@@ -1,14 +1,26 @@
 #pragma once
 
 #include "config.hpp"
+#include "http_archive.hpp"
 #include "dex_client.hpp"
 #include "jupiter_client.hpp"
 #include "db_manager.hpp"
 #include "redis_publisher.hpp"
 #include "pool_cache.hpp"
+#include "ohlcv_aggregator.hpp"
+#include "account_subscriber.hpp"
+#include "reserve_refresher.hpp"
+#include "refresh_scheduler.hpp"
+#include "rate_limiter.hpp"
+#include "price_graph.hpp"
+#include "shard_coordinator.hpp"
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class Service {
 public:
@@ -20,16 +32,41 @@ public:
 
 private:
     void tick();
+    std::chrono::steady_clock::duration tick_interval() const;
     void save_snapshot_if_needed();
+    void save_completed_bars();
+    void refresh_hot_pools();
+    void sweep_cold_pools();
+    std::unordered_map<std::string, PoolInfo> apply_reserve_updates(const std::vector<ReserveUpdate>& reserve_updates);
+    void publish_changed_pools(const std::unordered_map<std::string, PoolInfo>& changed);
+    void check_prices_against_jupiter();
+    void warm_start();
+    void write_state_snapshot_file();
+    std::optional<PoolInfo> apply_reserve_update(const std::string& pool_id, bool is_token_a, double reserve);
+    void on_reserve_update(const std::string& pool_id, bool is_token_a, double reserve);
     MarketUpdate create_market_update(const PoolInfo& pool_info);
 
     const Config& config_;
+    HttpArchive http_archive_;
     DexClient dex_client_;
     JupiterClient jupiter_client_;
     DatabaseManager db_manager_;
     RedisPublisher redis_publisher_;
     PoolCache pool_cache_;
+    OHLCVAggregator ohlcv_aggregator_;
+    // Reserve callbacks reach these, so they must outlive the subscriber
+    PriceGraph price_graph_;
+    ShardCoordinator shard_coordinator_;
+    AccountSubscriber account_subscriber_;
+    ReserveRefresher reserve_refresher_;
+    RefreshScheduler refresh_scheduler_;
+    RateLimiter pool_fetch_limiter_;
 
     std::atomic<bool> running_{false};
     std::chrono::steady_clock::time_point last_db_save_;
+    std::chrono::steady_clock::time_point next_hot_refresh_;
+    std::chrono::steady_clock::time_point next_cold_sweep_;
+    std::chrono::steady_clock::time_point next_price_check_;
+    size_t price_check_cursor_ = 0;
+    std::future<void> warm_start_;
 };
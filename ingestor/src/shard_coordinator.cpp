@@ -0,0 +1,260 @@
+#include "shard_coordinator.hpp"
+#include <sw/redis++/redis++.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Compare-and-renew / compare-and-delete, so a lease taken over by a peer is never touched
+const std::string kRenewScript =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then "
+    "return redis.call('PEXPIRE', KEYS[1], ARGV[2]) else return 0 end";
+const std::string kReleaseScript =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then "
+    "return redis.call('DEL', KEYS[1]) else return 0 end";
+
+// Stop trusting our leases this long before they could have expired in Redis
+constexpr auto kLeaseSafetyMargin = std::chrono::seconds(2);
+
+// FNV-1a: unlike std::hash, identical across builds and processes
+uint64_t stable_hash(const std::string& value) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+class ShardCoordinator::Impl {
+public:
+    explicit Impl(const Config& config)
+        : config_(config),
+          owned_(config.sharding_enabled ? static_cast<size_t>(config.shard_count) : 0, false),
+          members_key_(config.redis_shard_prefix + ":members") {
+        if (!config_.sharding_enabled) {
+            return;
+        }
+        
+        try {
+            sw::redis::ConnectionOptions connection_opts;
+            connection_opts.host = config_.redis_host;
+            connection_opts.port = config_.redis_port;
+            
+            if (!config_.redis_password.empty()) {
+                connection_opts.password = config_.redis_password;
+            }
+            
+            sw::redis::ConnectionPoolOptions pool_opts;
+            pool_opts.size = 1;
+            
+            redis_ = std::make_unique<sw::redis::Redis>(connection_opts, pool_opts);
+            
+            spdlog::info("Shard coordinator for instance {} ({} shards, {}s leases)",
+                        config_.instance_id, config_.shard_count, config_.shard_lease_seconds);
+        } catch (const std::exception& e) {
+            spdlog::error("Shard coordinator failed to connect to Redis: {}", e.what());
+            redis_ = nullptr;
+        }
+    }
+    
+    ~Impl() {
+        stop();
+    }
+    
+    void start() {
+        if (!config_.sharding_enabled || !redis_ || worker_.joinable()) {
+            return;
+        }
+        
+        maintain();
+        
+        stopping_ = false;
+        worker_ = std::thread([this]() {
+            auto period = std::chrono::seconds(config_.shard_lease_seconds) / 3;
+            std::unique_lock<std::mutex> lock(worker_mutex_);
+            while (!worker_cv_.wait_for(lock, period, [this]() { return stopping_; })) {
+                lock.unlock();
+                maintain();
+                lock.lock();
+            }
+        });
+    }
+    
+    void stop() {
+        if (!worker_.joinable()) {
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(worker_mutex_);
+            stopping_ = true;
+        }
+        worker_cv_.notify_all();
+        worker_.join();
+        release_all();
+    }
+    
+    bool owns(const std::string& pool_id) const {
+        if (!config_.sharding_enabled) {
+            return true;
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::chrono::steady_clock::now() >= valid_until_) {
+            return false;
+        }
+        return owned_[stable_hash(pool_id) % owned_.size()];
+    }
+    
+    bool enabled() const {
+        return config_.sharding_enabled;
+    }
+    
+    size_t owned_shard_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<size_t>(std::count(owned_.begin(), owned_.end(), true));
+    }
+
+private:
+    // Heartbeat, renew held leases, hand back shards now assigned elsewhere and
+    // try to take the ones assigned here
+    void maintain() {
+        auto started = std::chrono::steady_clock::now();
+        auto lease_ms = std::chrono::milliseconds(std::chrono::seconds(config_.shard_lease_seconds));
+        
+        try {
+            auto members = live_members(lease_ms.count());
+            
+            size_t gained = 0;
+            size_t lost = 0;
+            for (size_t shard = 0; shard < owned_.size(); ++shard) {
+                bool assigned = assigned_owner(shard, members) == config_.instance_id;
+                bool held = is_owned(shard);
+                auto key = lease_key(shard);
+                
+                if (held && assigned) {
+                    if (redis_->eval<long long>(kRenewScript, {key}, {config_.instance_id, std::to_string(lease_ms.count())}) == 0) {
+                        set_owned(shard, false);
+                        ++lost;
+                    }
+                } else if (held) {
+                    // Stop publishing before the peer can take the lease
+                    set_owned(shard, false);
+                    redis_->eval<long long>(kReleaseScript, {key}, {config_.instance_id});
+                    ++lost;
+                } else if (assigned) {
+                    if (redis_->set(key, config_.instance_id, lease_ms, sw::redis::UpdateType::NOT_EXIST)) {
+                        set_owned(shard, true);
+                        ++gained;
+                    }
+                }
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                valid_until_ = started + std::chrono::seconds(config_.shard_lease_seconds) - kLeaseSafetyMargin;
+            }
+            
+            if (gained > 0 || lost > 0) {
+                spdlog::info("Shard ownership changed: +{} -{}, holding {}/{} shards across {} instances",
+                            gained, lost, owned_shard_count(), owned_.size(), members.size());
+            }
+        } catch (const std::exception& e) {
+            // Leases keep counting down in Redis; owns() turns false once they may have lapsed
+            spdlog::warn("Shard lease maintenance failed: {}", e.what());
+        }
+    }
+    
+    void release_all() {
+        try {
+            for (size_t shard = 0; shard < owned_.size(); ++shard) {
+                if (!is_owned(shard)) continue;
+                
+                set_owned(shard, false);
+                redis_->eval<long long>(kReleaseScript, {lease_key(shard)}, {config_.instance_id});
+            }
+            redis_->zrem(members_key_, config_.instance_id);
+            spdlog::info("Released all shard leases");
+        } catch (const std::exception& e) {
+            spdlog::warn("Failed to release shard leases: {}", e.what());
+        }
+    }
+    
+    // Register our heartbeat and return every instance whose heartbeat is still live
+    std::vector<std::string> live_members(int64_t lease_ms) {
+        int64_t now = now_ms();
+        redis_->zadd(members_key_, config_.instance_id, static_cast<double>(now + lease_ms));
+        redis_->zremrangebyscore(members_key_,
+                                 sw::redis::RightBoundedInterval<double>(static_cast<double>(now), sw::redis::BoundType::OPEN));
+        
+        std::vector<std::string> members;
+        redis_->zrangebyscore(members_key_,
+                              sw::redis::LeftBoundedInterval<double>(static_cast<double>(now), sw::redis::BoundType::OPEN),
+                              std::back_inserter(members));
+        return members;
+    }
+    
+    // Rendezvous hashing: the member with the highest hash for the shard wins,
+    // so a membership change only moves the shards the joining/leaving member wins/held
+    static std::string assigned_owner(size_t shard, const std::vector<std::string>& members) {
+        std::string owner;
+        uint64_t best = 0;
+        for (const auto& member : members) {
+            uint64_t score = stable_hash(member + "#" + std::to_string(shard));
+            if (owner.empty() || score > best) {
+                owner = member;
+                best = score;
+            }
+        }
+        return owner;
+    }
+    
+    std::string lease_key(size_t shard) const {
+        return config_.redis_shard_prefix + ":lease:" + std::to_string(shard);
+    }
+    
+    bool is_owned(size_t shard) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return owned_[shard];
+    }
+    
+    void set_owned(size_t shard, bool owned) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        owned_[shard] = owned;
+    }
+    
+    const Config& config_;
+    std::unique_ptr<sw::redis::Redis> redis_;
+    mutable std::mutex mutex_;
+    std::vector<bool> owned_;
+    std::chrono::steady_clock::time_point valid_until_;
+    std::string members_key_;
+    std::thread worker_;
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    bool stopping_ = false;
+};
+
+// --- PIMPL forward declarations ---
+ShardCoordinator::ShardCoordinator(const Config& config) : pImpl_(std::make_unique<Impl>(config)) {}
+ShardCoordinator::~ShardCoordinator() = default;
+void ShardCoordinator::start() { pImpl_->start(); }
+void ShardCoordinator::stop() { pImpl_->stop(); }
+bool ShardCoordinator::owns(const std::string& pool_id) const { return pImpl_->owns(pool_id); }
+bool ShardCoordinator::enabled() const { return pImpl_->enabled(); }
+size_t ShardCoordinator::owned_shard_count() const { return pImpl_->owned_shard_count(); }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "config.hpp"
+#include <memory>
+#include <string>
+
+// Splits the pool universe between ingestor instances. Pools hash into a fixed
+// number of shards; each shard is assigned to one live instance by rendezvous
+// hashing over the instance set registered in Redis, and only published by the
+// holder of its Redis lease. Instances that join or die shift only the shards
+// whose assignment changes, once the old lease is released or expires.
+class ShardCoordinator {
+public:
+    explicit ShardCoordinator(const Config& config);
+    ~ShardCoordinator();
+    
+    // Claim the shards assigned to this instance, then keep renewing on a
+    // background thread (three times per lease period) so slow ticks cannot
+    // let the leases lapse
+    void start();
+    
+    // Stop renewing and drop every lease so peers can take over without
+    // waiting for the TTL
+    void stop();
+    
+    // Whether this instance currently holds the lease of the pool's shard.
+    // Always true when sharding is disabled.
+    bool owns(const std::string& pool_id) const;
+    
+    bool enabled() const;
+    size_t owned_shard_count() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Thin wrapper over the widest double vector the target offers, so batch
+// kernels are written once and run 4 (AVX), 2 (SSE2) or 1 lane wide.
+namespace simd {
+
+#if defined(__AVX__)
+using vd = __m256d;
+constexpr size_t kLanes = 4;
+inline vd vload(const double* p) { return _mm256_loadu_pd(p); }
+inline void vstore(double* p, vd v) { _mm256_storeu_pd(p, v); }
+inline vd vset(double x) { return _mm256_set1_pd(x); }
+inline vd vadd(vd a, vd b) { return _mm256_add_pd(a, b); }
+inline vd vsub(vd a, vd b) { return _mm256_sub_pd(a, b); }
+inline vd vmul(vd a, vd b) { return _mm256_mul_pd(a, b); }
+inline vd vdiv(vd a, vd b) { return _mm256_div_pd(a, b); }
+inline vd vsqrt(vd a) { return _mm256_sqrt_pd(a); }
+inline vd vmax(vd a, vd b) { return _mm256_max_pd(a, b); }
+inline vd vcmp_ge(vd a, vd b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+inline vd vand(vd a, vd b) { return _mm256_and_pd(a, b); }
+inline int vmovemask(vd m) { return _mm256_movemask_pd(m); }
+#elif defined(__SSE2__)
+using vd = __m128d;
+constexpr size_t kLanes = 2;
+inline vd vload(const double* p) { return _mm_loadu_pd(p); }
+inline void vstore(double* p, vd v) { _mm_storeu_pd(p, v); }
+inline vd vset(double x) { return _mm_set1_pd(x); }
+inline vd vadd(vd a, vd b) { return _mm_add_pd(a, b); }
+inline vd vsub(vd a, vd b) { return _mm_sub_pd(a, b); }
+inline vd vmul(vd a, vd b) { return _mm_mul_pd(a, b); }
+inline vd vdiv(vd a, vd b) { return _mm_div_pd(a, b); }
+inline vd vsqrt(vd a) { return _mm_sqrt_pd(a); }
+inline vd vmax(vd a, vd b) { return _mm_max_pd(a, b); }
+inline vd vcmp_ge(vd a, vd b) { return _mm_cmpge_pd(a, b); }
+inline vd vand(vd a, vd b) { return _mm_and_pd(a, b); }
+inline int vmovemask(vd m) { return _mm_movemask_pd(m); }
+#else
+using vd = double;
+constexpr size_t kLanes = 1;
+inline vd vload(const double* p) { return *p; }
+inline void vstore(double* p, vd v) { *p = v; }
+inline vd vset(double x) { return x; }
+inline vd vadd(vd a, vd b) { return a + b; }
+inline vd vsub(vd a, vd b) { return a - b; }
+inline vd vmul(vd a, vd b) { return a * b; }
+inline vd vdiv(vd a, vd b) { return a / b; }
+inline vd vsqrt(vd a) { return std::sqrt(a); }
+inline vd vmax(vd a, vd b) { return std::max(a, b); }
+inline vd vcmp_ge(vd a, vd b) { return a >= b ? 1.0 : 0.0; }
+inline vd vand(vd a, vd b) { return (a != 0.0 && b != 0.0) ? 1.0 : 0.0; }
+inline int vmovemask(vd m) { return m != 0.0 ? 1 : 0; }
+#endif
+
+} // namespace simd
@@ -0,0 +1,162 @@
+#include "state_snapshot.hpp"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+int64_t to_ms(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_ms(int64_t ms) {
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+}
+
+nlohmann::json pool_to_json(const PoolInfo& pool) {
+    return {
+        {"pool_id", pool.pool_id},
+        {"dex_name", pool.dex_name},
+        {"pool_type", pool.pool_type},
+        {"token_a", {
+            {"address", pool.token_a.address},
+            {"symbol", pool.token_a.symbol},
+            {"decimals", pool.token_a.decimals}
+        }},
+        {"token_b", {
+            {"address", pool.token_b.address},
+            {"symbol", pool.token_b.symbol},
+            {"decimals", pool.token_b.decimals}
+        }},
+        {"vault_a", pool.vault_a},
+        {"vault_b", pool.vault_b},
+        {"reserve_a", pool.reserve_a},
+        {"reserve_b", pool.reserve_b},
+        {"tvl_usd", pool.tvl_usd},
+        {"volume_24h_usd", pool.volume_24h_usd},
+        {"price_token_a_in_b", pool.price_token_a_in_b},
+        {"price_token_b_in_a", pool.price_token_b_in_a},
+        {"price_impact_1pct", pool.price_impact_1pct},
+        {"price_impact_1k", pool.price_impact_1k},
+        {"price_impact_10k", pool.price_impact_10k},
+        {"fee_rate", pool.fee_rate},
+        {"last_updated", to_ms(pool.last_updated)}
+    };
+}
+
+PoolInfo pool_from_json(const nlohmann::json& item) {
+    PoolInfo pool;
+    pool.pool_id = item.at("pool_id").get<std::string>();
+    pool.dex_name = item.value("dex_name", "");
+    pool.pool_type = item.value("pool_type", "");
+    pool.token_a.address = item.at("token_a").at("address").get<std::string>();
+    pool.token_a.symbol = item["token_a"].value("symbol", "");
+    pool.token_a.decimals = item["token_a"].value("decimals", 0);
+    pool.token_b.address = item.at("token_b").at("address").get<std::string>();
+    pool.token_b.symbol = item["token_b"].value("symbol", "");
+    pool.token_b.decimals = item["token_b"].value("decimals", 0);
+    pool.vault_a = item.value("vault_a", "");
+    pool.vault_b = item.value("vault_b", "");
+    pool.reserve_a = item.value("reserve_a", 0.0);
+    pool.reserve_b = item.value("reserve_b", 0.0);
+    pool.tvl_usd = item.value("tvl_usd", 0.0);
+    pool.volume_24h_usd = item.value("volume_24h_usd", 0.0);
+    pool.price_token_a_in_b = item.value("price_token_a_in_b", 0.0);
+    pool.price_token_b_in_a = item.value("price_token_b_in_a", 0.0);
+    pool.price_impact_1pct = item.value("price_impact_1pct", 0.0);
+    pool.price_impact_1k = item.value("price_impact_1k", 0.0);
+    pool.price_impact_10k = item.value("price_impact_10k", 0.0);
+    pool.fee_rate = item.value("fee_rate", pool.fee_rate);
+    pool.last_updated = from_ms(item.value("last_updated", int64_t{0}));
+    return pool;
+}
+
+nlohmann::json bar_to_json(const OHLCVBar& bar) {
+    return {
+        {"pool_id", bar.pool_id},
+        {"interval_minutes", bar.interval_minutes},
+        {"timestamp", to_ms(bar.timestamp)},
+        {"open", bar.open},
+        {"high", bar.high},
+        {"low", bar.low},
+        {"close", bar.close},
+        {"volume", bar.volume}
+    };
+}
+
+OHLCVBar bar_from_json(const nlohmann::json& item) {
+    OHLCVBar bar;
+    bar.pool_id = item.at("pool_id").get<std::string>();
+    bar.interval_minutes = item.at("interval_minutes").get<int>();
+    bar.timestamp = from_ms(item.at("timestamp").get<int64_t>());
+    bar.open = item.value("open", 0.0);
+    bar.high = item.value("high", 0.0);
+    bar.low = item.value("low", 0.0);
+    bar.close = item.value("close", 0.0);
+    bar.volume = item.value("volume", 0.0);
+    return bar;
+}
+
+} // namespace
+
+bool write_state_snapshot(const std::string& path, const StateSnapshot& snapshot) {
+    nlohmann::json doc;
+    doc["written_at"] = to_ms(snapshot.written_at);
+    doc["pools"] = nlohmann::json::array();
+    for (const auto& pool : snapshot.pools) {
+        doc["pools"].push_back(pool_to_json(pool));
+    }
+    doc["open_bars"] = nlohmann::json::array();
+    for (const auto& bar : snapshot.open_bars) {
+        doc["open_bars"].push_back(bar_to_json(bar));
+    }
+    
+    // A crash mid-write must not leave a truncated file behind for the next start
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) {
+            spdlog::warn("Cannot open state snapshot {} for writing", tmp_path);
+            return false;
+        }
+        out << doc.dump();
+        if (!out.good()) {
+            spdlog::warn("Failed to write state snapshot {}", tmp_path);
+            return false;
+        }
+    }
+    
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        spdlog::warn("Failed to move state snapshot into place at {}", path);
+        return false;
+    }
+    
+    spdlog::debug("Wrote state snapshot with {} pools and {} open bars to {}",
+                 snapshot.pools.size(), snapshot.open_bars.size(), path);
+    return true;
+}
+
+std::optional<StateSnapshot> read_state_snapshot(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return std::nullopt;
+    }
+    
+    try {
+        auto doc = nlohmann::json::parse(in);
+        
+        StateSnapshot snapshot;
+        snapshot.written_at = from_ms(doc.at("written_at").get<int64_t>());
+        for (const auto& item : doc.value("pools", nlohmann::json::array())) {
+            snapshot.pools.push_back(pool_from_json(item));
+        }
+        for (const auto& item : doc.value("open_bars", nlohmann::json::array())) {
+            snapshot.open_bars.push_back(bar_from_json(item));
+        }
+        return snapshot;
+    } catch (const std::exception& e) {
+        spdlog::warn("Ignoring unreadable state snapshot {}: {}", path, e.what());
+        return std::nullopt;
+    }
+}
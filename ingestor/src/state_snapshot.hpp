@@ -0,0 +1,22 @@
+#pragma once
+
+#include "types.hpp"
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Local copy of the ingestor's in-memory state, written alongside the
+// Postgres snapshot and on shutdown so a restart can resume with a populated
+// cache and the bars that were still open
+struct StateSnapshot {
+    std::chrono::system_clock::time_point written_at;
+    std::vector<PoolInfo> pools;
+    std::vector<OHLCVBar> open_bars;
+};
+
+// Write atomically (temp file + rename); returns false on any I/O error
+bool write_state_snapshot(const std::string& path, const StateSnapshot& snapshot);
+
+// nullopt when the file is missing or unreadable
+std::optional<StateSnapshot> read_state_snapshot(const std::string& path);
@@ -10,12 +10,18 @@ struct PoolInfo {
     std::string token_a_mint;
     std::string token_b_mint;
     std::string dex_name;
+    std::string pool_type = "constant-product";  // or "stable"
+    double fee_rate = 0.003;
+    std::string vault_a;  // SPL token account holding reserve_a
+    std::string vault_b;  // SPL token account holding reserve_b
     double reserve_a = 0.0;
     double reserve_b = 0.0;
     double tvl_usd = 0.0;
     double volume_24h_usd = 0.0;
     double price_a_in_b = 0.0;
     double price_impact_1pct = 0.0;
+    double price_impact_1k = 0.0;   // spot move (%) for a $1k sell of token A
+    double price_impact_10k = 0.0;  // spot move (%) for a $10k sell of token A
     std::chrono::system_clock::time_point last_updated;
     std::chrono::system_clock::time_point first_seen;
     bool is_active = true;
@@ -56,5 +62,10 @@ struct MarketUpdate {
     std::string pool_id;
     std::string event_type; // "pool_update", "ohlcv_bar", "route_health"
     std::string data_json;
+    std::optional<double> price_impact_1k;
+    std::optional<double> price_impact_10k;
+    std::optional<double> price_usd;           // token A, from the price graph
+    std::optional<int> route_hops;
+    std::optional<double> route_deviation_pct;
     std::chrono::system_clock::time_point timestamp;
 };
@@ -9,6 +9,8 @@
 #include <cmath>
 #include <iomanip>
 #include <chrono>
+#include <array>
+#include <cstdint>
 
 namespace util {
 
@@ -130,6 +132,40 @@ double safe_parse_double(const std::string& str, double default_value) {
     }
 }
 
+std::string base64_decode(const std::string& encoded) {
+    static const auto lookup = [] {
+        std::array<int8_t, 256> table{};
+        table.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) {
+            table[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+        }
+        return table;
+    }();
+    
+    std::string decoded;
+    decoded.reserve(encoded.size() / 4 * 3);
+    
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (unsigned char c : encoded) {
+        if (c == '=') break;
+        int8_t value = lookup[c];
+        if (value < 0) {
+            throw std::runtime_error("Invalid base64 character");
+        }
+        
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            decoded.push_back(static_cast<char>((buffer >> bits) & 0xFF));
+        }
+    }
+    
+    return decoded;
+}
+
 double calculate_price_impact(double reserve_x, double reserve_y, double trade_amount) {
     if (reserve_x <= 0 || reserve_y <= 0 || trade_amount <= 0) {
         return 0.0;
@@ -33,6 +33,9 @@ bool is_valid_solana_address(const std::string& address);
 bool is_valid_pool_id(const std::string& pool_id);
 double safe_parse_double(const std::string& str, double default_value = 0.0);
 
+// Encoding utilities
+std::string base64_decode(const std::string& encoded);
+
 // Math utilities
 double calculate_price_impact(double reserve_x, double reserve_y, double trade_amount);
 double calculate_k_constant(double reserve_x, double reserve_y);
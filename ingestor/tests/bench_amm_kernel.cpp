@@ -0,0 +1,193 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "amm_kernel.hpp"
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+constexpr size_t kPoolCount = 100000;
+
+// Amplification compute_pool_impacts assumes for stable pools
+constexpr double kStableAmp = 100.0;
+
+// 100k pools, about one in five of them StableSwap, with reserves spread
+// over seven orders of magnitude. A few have no TVL, so their USD-sized
+// impacts come out as zero.
+std::vector<PoolInfo> make_pools(size_t count) {
+    std::mt19937_64 rng(20241016);
+    std::uniform_real_distribution<double> log_reserve(2.0, 9.0);
+    std::uniform_real_distribution<double> imbalance(0.5, 2.0);
+    std::uniform_real_distribution<double> price(1e-6, 1e3);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    
+    std::vector<PoolInfo> pools(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto& pool = pools[i];
+        pool.pool_id = "pool-" + std::to_string(i);
+        pool.reserve_a = std::pow(10.0, log_reserve(rng));
+        
+        if (unit(rng) < 0.2) {
+            pool.pool_type = "stable";
+            pool.fee_rate = 0.0004;
+            pool.reserve_b = pool.reserve_a * imbalance(rng);
+            pool.tvl_usd = pool.reserve_a + pool.reserve_b;
+        } else {
+            pool.pool_type = "constant-product";
+            pool.fee_rate = 0.003;
+            double price_a_usd = price(rng);
+            pool.reserve_b = pool.reserve_a * price(rng);
+            pool.tvl_usd = 2.0 * pool.reserve_a * price_a_usd;
+        }
+        
+        if (unit(rng) < 0.02) {
+            pool.tvl_usd = 0.0;
+        }
+    }
+    return pools;
+}
+
+// The path DexClient takes for a single targeted fetch
+void compute_one_by_one(std::vector<PoolInfo>& pools) {
+    for (auto& pool : pools) {
+        std::vector<PoolInfo> single{pool};
+        amm::compute_pool_impacts(single);
+        pool.price_impact_1pct = single.front().price_impact_1pct;
+        pool.price_impact_1k = single.front().price_impact_1k;
+        pool.price_impact_10k = single.front().price_impact_10k;
+    }
+}
+
+// Token A sold into a pool for a USD notional, as compute_pool_impacts sizes it
+double sell_amount(const PoolInfo& pool, double usd) {
+    return pool.tvl_usd > 0 ? pool.reserve_a / (pool.tvl_usd / 2.0) * usd : 0.0;
+}
+
+// Closed form for x*y=k: 100 * (1 - (x / (x + dx(1 - f)))^2)
+double constant_product_reference(const PoolInfo& pool, double dx) {
+    double x = pool.reserve_a;
+    double ratio = x / (x + dx * (1.0 - pool.fee_rate));
+    return 100.0 * (1.0 - ratio * ratio);
+}
+
+// Two-coin StableSwap invariant, 4A(x+y) + D - 4AD - D^3/(4xy); zero on the curve
+double stableswap_residual(double x, double y, double d) {
+    double ann = 4.0 * kStableAmp;
+    return ann * (x + y) + d - ann * d - d * d * d / (4.0 * x * y);
+}
+
+// Root of an increasing function by bisection, independent of the kernel's Newton steps
+template <typename F>
+double bisect(F&& f, double lo, double hi) {
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        (f(mid) < 0.0 ? lo : hi) = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+double stableswap_price(double x, double y, double d) {
+    double ann = 4.0 * kStableAmp;
+    double d3 = d * d * d;
+    return (ann + d3 / (4.0 * x * x * y)) / (ann + d3 / (4.0 * x * y * y));
+}
+
+struct StableReference {
+    double impact_pct;
+    double residual;  // of the invariant at the solved y, relative to 4AD
+};
+
+// Solve D from the reserves, then y after selling dx, straight off the invariant
+StableReference stableswap_reference(const PoolInfo& pool, double dx) {
+    double x = pool.reserve_a;
+    double y = pool.reserve_b;
+    
+    // The residual falls from 4A(x+y) at D = 0 to at most zero at D = x + y
+    double d = bisect([&](double dd) { return -stableswap_residual(x, y, dd); }, 0.0, x + y);
+    
+    double x1 = x + dx * (1.0 - pool.fee_rate);
+    double hi = y;
+    while (stableswap_residual(x1, hi, d) < 0.0) {
+        hi *= 2.0;
+    }
+    double y1 = bisect([&](double yy) { return stableswap_residual(x1, yy, d); }, 0.0, hi);
+    
+    double impact = 100.0 * (1.0 - stableswap_price(x1, y1, d) / stableswap_price(x, y, d));
+    return {impact, stableswap_residual(x1, y1, d) / (4.0 * kStableAmp * d)};
+}
+
+} // namespace
+
+TEST_CASE("Batched AMM kernel matches the per-pool path", "[amm_kernel]") {
+    auto batched = make_pools(kPoolCount);
+    auto single = batched;
+    
+    amm::compute_pool_impacts(batched);
+    compute_one_by_one(single);
+    
+    size_t mismatches = 0;
+    for (size_t i = 0; i < kPoolCount; ++i) {
+        if (batched[i].price_impact_1pct != single[i].price_impact_1pct ||
+            batched[i].price_impact_1k != single[i].price_impact_1k ||
+            batched[i].price_impact_10k != single[i].price_impact_10k) {
+            ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+    
+    // Spot-check that the impacts are sane: selling 1% of reserves moves the
+    // price by a little under 2% (less on stable pools), never by nothing
+    for (size_t i = 0; i < kPoolCount; i += 997) {
+        const auto& pool = batched[i];
+        CHECK(pool.price_impact_1pct > 0.0);
+        CHECK(pool.price_impact_1pct < 2.0);
+        CHECK(pool.price_impact_10k >= pool.price_impact_1k);
+    }
+}
+
+TEST_CASE("AMM kernel impacts match the closed-form curves", "[amm_kernel]") {
+    auto pools = make_pools(kPoolCount);
+    amm::compute_pool_impacts(pools);
+    
+    for (size_t i = 0; i < kPoolCount; i += 101) {
+        const auto& pool = pools[i];
+        INFO(pool.pool_id << " " << pool.pool_type << " x=" << pool.reserve_a << " y=" << pool.reserve_b);
+        
+        const std::pair<double, double> trades[] = {
+            {pool.reserve_a * 0.01, pool.price_impact_1pct},
+            {sell_amount(pool, 1000.0), pool.price_impact_1k},
+            {sell_amount(pool, 10000.0), pool.price_impact_10k},
+        };
+        for (const auto& [dx, impact] : trades) {
+            double expected;
+            if (pool.pool_type == "stable") {
+                auto reference = stableswap_reference(pool, dx);
+                CHECK(std::abs(reference.residual) < 1e-12);
+                expected = reference.impact_pct;
+            } else {
+                expected = constant_product_reference(pool, dx);
+            }
+            CHECK_THAT(impact, WithinRel(expected, 1e-6) || WithinAbs(expected, 1e-9));
+        }
+    }
+}
+
+TEST_CASE("Batched AMM kernel over 100k pools", "[.][benchmark][amm_kernel]") {
+    auto pools = make_pools(kPoolCount);
+    
+    BENCHMARK("batched kernel, 100k pools") {
+        amm::compute_pool_impacts(pools);
+        return pools.front().price_impact_1pct;
+    };
+    
+    BENCHMARK("per-pool path, 100k pools") {
+        compute_one_by_one(pools);
+        return pools.front().price_impact_1pct;
+    };
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "account_subscriber.hpp"
+#include "pool_cache.hpp"
+#include <ixwebsocket/IXWebSocketServer.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr int kMockPort = 18931;
+constexpr uint64_t kSubscriptionBase = 4000;
+
+// Polls until pred() holds or the timeout expires
+template <typename Pred>
+bool wait_for(Pred pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+}
+
+// The balance the mock node reports for each vault, as a jsonParsed SPL
+// token account notification
+nlohmann::json account_notification(uint64_t subscription, const std::string& ui_amount) {
+    return {
+        {"jsonrpc", "2.0"},
+        {"method", "accountNotification"},
+        {"params", {
+            {"subscription", subscription},
+            {"result", {
+                {"context", {{"slot", 250000000}}},
+                {"value", {
+                    {"lamports", 2039280},
+                    {"owner", "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA"},
+                    {"data", {
+                        {"program", "spl-token"},
+                        {"parsed", {
+                            {"type", "account"},
+                            {"info", {
+                                {"tokenAmount", {
+                                    {"amount", "0"},
+                                    {"decimals", 6},
+                                    {"uiAmountString", ui_amount}
+                                }}
+                            }}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+}
+
+} // namespace
+
+TEST_CASE("AccountSubscriber streams vault balances into PoolCache", "[account_subscriber]") {
+    // Minimal stand-in for a Solana node: acknowledges accountSubscribe and
+    // immediately pushes one notification for the subscribed vault
+    ix::WebSocketServer server(kMockPort, "127.0.0.1");
+    server.setOnClientMessageCallback(
+        [](std::shared_ptr<ix::ConnectionState>, ix::WebSocket& socket, const ix::WebSocketMessagePtr& msg) {
+            if (msg->type != ix::WebSocketMessageType::Message) return;
+            
+            auto request = nlohmann::json::parse(msg->str);
+            if (request.value("method", "") != "accountSubscribe") return;
+            
+            uint64_t id = request["id"].get<uint64_t>();
+            std::string vault = request["params"][0].get<std::string>();
+            uint64_t subscription = kSubscriptionBase + id;
+            
+            socket.send(nlohmann::json{{"jsonrpc", "2.0"}, {"id", id}, {"result", subscription}}.dump());
+            socket.send(account_notification(subscription, vault == "VaultA" ? "1500.25" : "3000.5").dump());
+        });
+    
+    auto listening = server.listen();
+    REQUIRE(listening.first);
+    server.start();
+    
+    Config config;
+    config.solana_ws_urls = {"ws://127.0.0.1:" + std::to_string(kMockPort)};
+    config.account_subscribe_top_n = 10;
+    
+    PoolCache cache(config);
+    
+    PoolInfo pool;
+    pool.pool_id = "pool-1";
+    pool.vault_a = "VaultA";
+    pool.vault_b = "VaultB";
+    pool.reserve_a = 1000.0;
+    pool.reserve_b = 2000.0;
+    pool.tvl_usd = 50000.0;
+    pool.last_updated = std::chrono::system_clock::now();
+    cache.update_pool(pool);
+    
+    AccountSubscriber subscriber(config, [&cache](const std::string& pool_id, bool is_token_a, double reserve) {
+        cache.update_reserve(pool_id, is_token_a, reserve);
+    });
+    
+    // Wanted vaults are subscribed once the connection opens
+    subscriber.refresh_subscriptions(cache.get_top_pools_by_tvl(static_cast<size_t>(config.account_subscribe_top_n)));
+    subscriber.start();
+    
+    REQUIRE(wait_for([&] { return subscriber.subscription_count() == 2; }));
+    REQUIRE(wait_for([&] {
+        auto cached = cache.get_pool("pool-1");
+        return cached && cached->reserve_a != 1000.0 && cached->reserve_b != 2000.0;
+    }));
+    
+    auto cached = cache.get_pool("pool-1");
+    REQUIRE(cached.has_value());
+    CHECK(cached->reserve_a == Catch::Approx(1500.25));
+    CHECK(cached->reserve_b == Catch::Approx(3000.5));
+    
+    subscriber.stop();
+    server.stop();
+}
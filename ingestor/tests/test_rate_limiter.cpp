@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rate_limiter.hpp"
+#include <chrono>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+// 10 requests per second: one slot every 100 ms, 5 of them up front
+constexpr int kRate = 10;
+constexpr int kBurst = 5;
+constexpr auto kInterval = milliseconds(100);
+
+// Scheduling slack allowed on either side of a timed wait
+constexpr auto kSlack = milliseconds(40);
+
+} // namespace
+
+TEST_CASE("RateLimiter accepts a full burst, then refuses", "[rate_limiter]") {
+    RateLimiter limiter(kRate, kBurst);
+    
+    for (int i = 0; i < kBurst; ++i) {
+        CHECK(limiter.allow_request("api"));
+    }
+    CHECK_FALSE(limiter.allow_request("api"));
+    
+    // Endpoints have separate buckets
+    CHECK(limiter.allow_request("other"));
+}
+
+TEST_CASE("RateLimiter spaces requests by the emission interval once the burst is spent", "[rate_limiter]") {
+    RateLimiter limiter(kRate, kBurst);
+    for (int i = 0; i < kBurst; ++i) {
+        REQUIRE(limiter.allow_request("api"));
+    }
+    
+    auto wait = limiter.time_until_allowed("api");
+    CHECK(wait > milliseconds(0));
+    CHECK(wait <= kInterval);
+    
+    // Each acquire gets the next slot, one interval after the previous
+    auto start = Clock::now();
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(limiter.acquire("api", Clock::now() + milliseconds(1000)));
+    }
+    auto elapsed = Clock::now() - start;
+    CHECK(elapsed >= 3 * kInterval - kSlack);
+    CHECK(elapsed <= 3 * kInterval + kSlack);
+}
+
+TEST_CASE("RateLimiter refuses a request past its deadline without using a slot", "[rate_limiter]") {
+    RateLimiter limiter(kRate, kBurst);
+    for (int i = 0; i < kBurst; ++i) {
+        REQUIRE(limiter.allow_request("api"));
+    }
+    
+    // The next slot is up to an interval away, so a 10 ms deadline cannot be met
+    // and the refusal comes back at once instead of after sleeping
+    auto start = Clock::now();
+    CHECK_FALSE(limiter.acquire("api", start + milliseconds(10)));
+    CHECK_FALSE(limiter.acquire("api", start + milliseconds(10)));
+    CHECK(Clock::now() - start < milliseconds(10));
+    
+    // The refused requests reserved nothing: the next one still gets the first
+    // free slot, not one pushed back by the refusals
+    CHECK(limiter.time_until_allowed("api") <= kInterval);
+    REQUIRE(limiter.acquire("api", Clock::now() + milliseconds(1000)));
+    CHECK(Clock::now() - start <= kInterval + kSlack);
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "reserve_refresher.hpp"
+#include <ixwebsocket/IXHttpServer.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+constexpr int kStandInPort = 18932;
+
+// Recorded getMultipleAccounts reply for two SPL token vaults (165-byte
+// accounts, amount at offset 64). The first frame was written by one-shot
+// compression and records its content size; the second came out of a
+// streaming compressor and leaves it unknown (ZSTD_CONTENTSIZE_UNKNOWN).
+const char* kRecordedReply = R"({
+  "jsonrpc": "2.0",
+  "id": 1,
+  "result": {
+    "context": {"apiVersion": "1.18.22", "slot": 287394512},
+    "value": [
+      {
+        "data": ["KLUv/SSlxQAAUBERIlAE+3EfAQAFAMADSpUAeAw0VwRYbXclYg==", "base64+zstd"],
+        "executable": false,
+        "lamports": 2039280,
+        "owner": "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA",
+        "rentEpoch": 18446744073709551615,
+        "space": 165
+      },
+      {
+        "data": ["KLUv/QRYrQAAUBERIrFo3joAAQAEEAA8sVIbJrYBdl8Prw==", "base64+zstd"],
+        "executable": false,
+        "lamports": 2039280,
+        "owner": "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA",
+        "rentEpoch": 18446744073709551615,
+        "space": 165
+      }
+    ]
+  }
+})";
+
+// Stand-in RPC node that answers every request with the recorded reply
+class RecordedRpcServer {
+public:
+    RecordedRpcServer() : server_(kStandInPort, "127.0.0.1") {
+        server_.setOnConnectionCallback(
+            [this](ix::HttpRequestPtr request, std::shared_ptr<ix::ConnectionState>) -> ix::HttpResponsePtr {
+                last_request_ = nlohmann::json::parse(request->body, nullptr, false);
+                ix::WebSocketHttpHeaders headers;
+                headers["Content-Type"] = "application/json";
+                return std::make_shared<ix::HttpResponse>(
+                    200, "OK", ix::HttpErrorCode::Ok, headers, kRecordedReply);
+            });
+    }
+    
+    bool start() {
+        auto listening = server_.listen();
+        if (!listening.first) return false;
+        server_.start();
+        return true;
+    }
+    
+    ~RecordedRpcServer() { server_.stop(); }
+    
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(kStandInPort); }
+    const nlohmann::json& last_request() const { return last_request_; }
+
+private:
+    ix::HttpServer server_;
+    nlohmann::json last_request_;
+};
+
+} // namespace
+
+TEST_CASE("ReserveRefresher decodes recorded base64+zstd vault accounts", "[reserve_refresher]") {
+    RecordedRpcServer server;
+    REQUIRE(server.start());
+    
+    Config config;
+    config.solana_rpc_urls = {server.url()};
+    
+    PoolInfo pool;
+    pool.pool_id = "pool-1";
+    pool.vault_a = "VaultA";
+    pool.vault_b = "VaultB";
+    pool.token_a.decimals = 6;
+    pool.token_b.decimals = 9;
+    pool.reserve_a = 0.0;
+    pool.reserve_b = 0.0;
+    
+    ReserveRefresher refresher(config);
+    auto updates = refresher.refresh({pool});
+    
+    // Both vaults went out in a single base64+zstd request
+    const auto& request = server.last_request();
+    REQUIRE(request.value("method", "") == "getMultipleAccounts");
+    CHECK(request["params"][0] == nlohmann::json::array({"VaultA", "VaultB"}));
+    CHECK(request["params"][1]["encoding"] == "base64+zstd");
+    
+    REQUIRE(updates.size() == 2);
+    auto side_a = std::find_if(updates.begin(), updates.end(), [](const ReserveUpdate& u) { return u.is_token_a; });
+    auto side_b = std::find_if(updates.begin(), updates.end(), [](const ReserveUpdate& u) { return !u.is_token_a; });
+    REQUIRE(side_a != updates.end());
+    REQUIRE(side_b != updates.end());
+    
+    CHECK(side_a->pool_id == "pool-1");
+    CHECK(side_a->reserve == Catch::Approx(1234567.89));     // 1234567890000 / 10^6
+    
+    // Streamed frame without a recorded content size
+    CHECK(side_b->pool_id == "pool-1");
+    CHECK(side_b->reserve == Catch::Approx(0.987654321));    // 987654321 / 10^9
+}
+
+TEST_CASE("ReserveRefresher skips reserves that did not change", "[reserve_refresher]") {
+    RecordedRpcServer server;
+    REQUIRE(server.start());
+    
+    Config config;
+    config.solana_rpc_urls = {server.url()};
+    
+    PoolInfo pool;
+    pool.pool_id = "pool-1";
+    pool.vault_a = "VaultA";
+    pool.vault_b = "VaultB";
+    pool.token_a.decimals = 6;
+    pool.token_b.decimals = 9;
+    pool.reserve_a = 1234567890000.0 / 1e6;
+    pool.reserve_b = 0.0;
+    
+    ReserveRefresher refresher(config);
+    auto updates = refresher.refresh({pool});
+    
+    REQUIRE(updates.size() == 1);
+    CHECK_FALSE(updates[0].is_token_a);
+}
@@ -1,5 +1,6 @@
 
 #include "config.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <charconv>
 
@@ -27,6 +28,8 @@ void Config::load_from_env() {
     stream_alerts_out = get_env("STREAM_ALERTS_OUT", stream_alerts_out);
     stream_req = get_env("STREAM_REQ", stream_req);
     stream_rep = get_env("STREAM_REP", stream_rep);
+    stream_batch_size = std::max(1, get_env_int("STREAM_BATCH_SIZE", stream_batch_size));
+    stream_block_ms = std::max(1, get_env_int("STREAM_BLOCK_MS", stream_block_ms));
 
     pg_dsn = get_env("PG_DSN", pg_dsn);
 
@@ -1,8 +1,43 @@
 #include "redis_bus.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include <iterator>
+#include <unordered_map>
 #include <unistd.h> // for getpid()
 
+namespace {
+
+using StreamAttrs = std::unordered_map<std::string, std::string>;
+using StreamItem = std::pair<std::string, StreamAttrs>;
+using StreamBatch = std::vector<StreamItem>;
+
+// One XREADGROUP for up to `count` new entries. A full batch means the
+// consumer is behind, so the next read skips BLOCK and drains the backlog;
+// otherwise it blocks for up to `block` waiting for new entries.
+StreamBatch read_batch(sw::redis::Redis& redis, const std::string& group, const std::string& consumer,
+                       const std::string& stream, long long count, std::chrono::milliseconds block,
+                       bool backlog) {
+    std::unordered_map<std::string, StreamBatch> result;
+    if (backlog) {
+        redis.xreadgroup(group, consumer, stream, ">", count, std::inserter(result, result.end()));
+    } else {
+        redis.xreadgroup(group, consumer, stream, ">", block, count, std::inserter(result, result.end()));
+    }
+
+    auto it = result.find(stream);
+    return it == result.end() ? StreamBatch{} : std::move(it->second);
+}
+
+// Single multi-ID XACK for a processed batch
+void ack_batch(sw::redis::Redis& redis, const std::string& stream, const std::string& group,
+               const std::vector<std::string>& ids) {
+    if (!ids.empty()) {
+        redis.xack(stream, group, ids.begin(), ids.end());
+    }
+}
+
+} // namespace
+
 RedisBus::RedisBus(const Config& config) : config_(config) {
     ensure_connection();
 }
@@ -65,6 +100,9 @@ void RedisBus::alert_consumer_loop(std::function<void(const InboundAlert&)> call
         redis_->xgroup_create(config_.stream_alerts_in, consumer_group, "0", true);
     } catch (const sw::redis::Error&) { /* Group likely exists */ }
 
+    bool backlog = false;
+    std::vector<std::string> acked;
+
     while (running_) {
         try {
             if (!ensure_connection()) {
@@ -72,27 +110,32 @@ void RedisBus::alert_consumer_loop(std::function<void(const InboundAlert&)> call
                 continue;
             }
 
-            auto result = redis_->xreadgroup(consumer_group, consumer_name,
-                {{config_.stream_alerts_in, ">"}}, std::chrono::milliseconds(1000));
-
-            for (const auto& stream : result) {
-                for (const auto& msg : stream.second) {
-                    try {
-                        auto data_it = msg.second.find("data");
-                        if (data_it != msg.second.end()) {
-                            auto json = nlohmann::json::parse(data_it->second);
-                            auto alert = InboundAlert::from_json(json);
-                            callback(alert);
-                            redis_->xack(config_.stream_alerts_in, consumer_group, msg.first);
-                        }
-                    } catch (const std::exception& e) {
-                        spdlog::error("Failed to process inbound alert message: {}", e.what());
+            auto entries = read_batch(*redis_, consumer_group, consumer_name, config_.stream_alerts_in,
+                                      config_.stream_batch_size,
+                                      std::chrono::milliseconds(config_.stream_block_ms), backlog);
+            backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
+
+            acked.clear();
+            for (const auto& msg : entries) {
+                try {
+                    auto data_it = msg.second.find("data");
+                    if (data_it != msg.second.end()) {
+                        auto json = nlohmann::json::parse(data_it->second);
+                        auto alert = InboundAlert::from_json(json);
+                        callback(alert);
+                        acked.push_back(msg.first);
                     }
+                } catch (const std::exception& e) {
+                    spdlog::error("Failed to process inbound alert message: {}", e.what());
                 }
             }
+
+            // Acknowledge the whole batch in one round trip
+            ack_batch(*redis_, config_.stream_alerts_in, consumer_group, acked);
         } catch (const sw::redis::TimeoutError&) {
             // This is expected, just continue
         } catch (const std::exception& e) {
+            backlog = false;
             if (running_) {
                 spdlog::error("Alert consumer error: {}", e.what());
                 std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -111,6 +154,9 @@ void RedisBus::command_consumer_loop(std::function<void(const CommandRequest&)>
         redis_->xgroup_create(config_.stream_req, consumer_group, "0", true);
     } catch (const sw::redis::Error&) { /* Group likely exists */ }
 
+    bool backlog = false;
+    std::vector<std::string> acked;
+
     while (running_) {
         try {
             if (!ensure_connection()) {
@@ -118,27 +164,32 @@ void RedisBus::command_consumer_loop(std::function<void(const CommandRequest&)>
                 continue;
             }
 
-            auto result = redis_->xreadgroup(consumer_group, consumer_name,
-                {{config_.stream_req, ">"}}, std::chrono::milliseconds(1000));
-
-            for (const auto& stream : result) {
-                for (const auto& msg : stream.second) {
-                    try {
-                        auto data_it = msg.second.find("data");
-                        if (data_it != msg.second.end()) {
-                            auto json = nlohmann::json::parse(data_it->second);
-                            auto req = CommandRequest::from_json(json);
-                            callback(req);
-                            redis_->xack(config_.stream_req, consumer_group, msg.first);
-                        }
-                    } catch (const std::exception& e) {
-                        spdlog::error("Failed to process command request message: {}", e.what());
+            auto entries = read_batch(*redis_, consumer_group, consumer_name, config_.stream_req,
+                                      config_.stream_batch_size,
+                                      std::chrono::milliseconds(config_.stream_block_ms), backlog);
+            backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
+
+            acked.clear();
+            for (const auto& msg : entries) {
+                try {
+                    auto data_it = msg.second.find("data");
+                    if (data_it != msg.second.end()) {
+                        auto json = nlohmann::json::parse(data_it->second);
+                        auto req = CommandRequest::from_json(json);
+                        callback(req);
+                        acked.push_back(msg.first);
                     }
+                } catch (const std::exception& e) {
+                    spdlog::error("Failed to process command request message: {}", e.what());
                 }
             }
+
+            // Acknowledge the whole batch in one round trip
+            ack_batch(*redis_, config_.stream_req, consumer_group, acked);
         } catch (const sw::redis::TimeoutError&) {
             // This is expected, just continue
         } catch (const std::exception& e) {
+            backlog = false;
             if (running_) {
                 spdlog::error("Command consumer error: {}", e.what());
                 std::this_thread::sleep_for(std::chrono::seconds(5));
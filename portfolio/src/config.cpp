@@ -1,6 +1,7 @@
 
 #include "config.hpp"
 #include <cstdlib>
+#include <sstream>
 #include <spdlog/spdlog.h>
 
 std::string Config::get_env(const std::string& name, const std::string& default_val) {
@@ -38,8 +39,19 @@ Config Config::from_env() {
     config.redis_reply_channel = get_env_var("REDIS_REPLY_CHANNEL", "replies");
     config.redis_audit_channel = get_env_var("REDIS_AUDIT_CHANNEL", "audit");
     
-    // Solana
-    config.solana_rpc_url = get_env_var("SOLANA_RPC_URL", "https://api.mainnet-beta.solana.com");
+    // Solana (SOLANA_RPC_URL may carry a comma-separated list of endpoints)
+    std::string rpc_urls_str = get_env_var("SOLANA_RPC_URLS", get_env_var("SOLANA_RPC_URL", "https://api.mainnet-beta.solana.com"));
+    config.solana_rpc_urls.clear();
+    std::stringstream rpc_urls_stream(rpc_urls_str);
+    std::string rpc_url;
+    while (std::getline(rpc_urls_stream, rpc_url, ',')) {
+        if (!rpc_url.empty()) {
+            config.solana_rpc_urls.push_back(rpc_url);
+        }
+    }
+    if (!config.solana_rpc_urls.empty()) {
+        config.solana_rpc_url = config.solana_rpc_urls.front();
+    }
     
     // Price API
     config.price_api_url = get_env_var("PRICE_API_URL", "https://api.coingecko.com/api/v3");
@@ -57,6 +69,10 @@ void Config::validate() const {
         throw std::runtime_error("DATABASE_URL is required");
     }
     
+    if (solana_rpc_urls.empty()) {
+        throw std::runtime_error("At least one Solana RPC URL is required");
+    }
+    
     if (redis_host.empty()) {
         throw std::runtime_error("REDIS_HOST cannot be empty");
     }
@@ -2,6 +2,7 @@
 #pragma once
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 class Config {
 public:
@@ -20,8 +21,9 @@ public:
     std::string redis_reply_channel = "replies";
     std::string redis_audit_channel = "audit";
     
-    // Solana RPC
+    // Solana RPC (solana_rpc_urls is ranked by latency/errors at runtime)
     std::string solana_rpc_url = "https://api.mainnet-beta.solana.com";
+    std::vector<std::string> solana_rpc_urls = {"https://api.mainnet-beta.solana.com"};
     
     // Price API
     std::string price_api_url = "https://api.coingecko.com/api/v3";
@@ -0,0 +1,381 @@
+#include "rpc_endpoint_manager.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace {
+
+constexpr size_t kLatencyWindow = 64;            // samples kept for the p95 estimate
+constexpr size_t kMinSamplesForP95 = 8;
+constexpr auto kDefaultHedgeDelay = std::chrono::milliseconds(250);
+constexpr auto kMinHedgeDelay = std::chrono::milliseconds(20);
+constexpr int kFailuresBeforeCooldown = 3;
+constexpr auto kBaseCooldown = std::chrono::seconds(5);
+constexpr auto kMaxCooldown = std::chrono::seconds(60);
+
+// Long-lived threads that send fired hedges; a hedge that comes due while all
+// of them are busy is skipped
+constexpr size_t kHedgeWorkers = 2;
+
+} // namespace
+
+class RpcEndpointManager::Impl {
+public:
+    Impl(const std::vector<std::string>& urls, double ewma_alpha, double max_hedge_ratio)
+        : alpha_(ewma_alpha), max_hedge_ratio_(max_hedge_ratio) {
+        endpoints_.reserve(urls.size());
+        for (const auto& url : urls) {
+            endpoints_.push_back(EndpointStats{url});
+        }
+        
+        if (endpoints_.size() >= 2) {
+            timer_ = std::thread(&Impl::timer_loop, this);
+            for (size_t i = 0; i < kHedgeWorkers; ++i) {
+                workers_.emplace_back(&Impl::worker_loop, this);
+            }
+        }
+    }
+    
+    // Lets the hedges already sent finish; pending ones are dropped
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(hedges_mutex_);
+            stopping_ = true;
+        }
+        timer_cv_.notify_all();
+        workers_cv_.notify_all();
+        if (timer_.joinable()) {
+            timer_.join();
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+    
+    std::optional<std::string> execute(const RequestFunc& request, const std::vector<size_t>& order) {
+        for (size_t index : order) {
+            auto body = attempt(index, request);
+            if (body) {
+                return body;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    // The primary runs on the caller's thread. The hedge is armed on the
+    // timer thread, which hands it to an idle hedge worker once the primary's
+    // p95 passes, so at most one extra request per call is ever in flight and
+    // no thread is started per call.
+    std::optional<std::string> execute_hedged(const RequestFunc& request) {
+        auto order = ranking();
+        if (order.size() < 2) {
+            return execute(request, order);
+        }
+        
+        requests_++;
+        
+        auto hedge = std::make_shared<Hedge>();
+        hedge->backup = order[1];
+        hedge->request = request;
+        arm(std::chrono::steady_clock::now() + hedge_delay(order[0]), hedge);
+        
+        auto body = attempt(order[0], request);
+        bool fired;
+        {
+            std::lock_guard<std::mutex> lock(hedge->mutex);
+            hedge->primary_done = true;
+            fired = hedge->fired;
+        }
+        
+        if (body) {
+            // A hedge that already fired finishes in the background
+            return body;
+        }
+        
+        // Primary failed: take the hedge's answer if one went out
+        if (fired) {
+            std::unique_lock<std::mutex> lock(hedge->mutex);
+            hedge->cv.wait(lock, [&] { return hedge->done; });
+            if (hedge->result) {
+                return std::move(hedge->result);
+            }
+        }
+        
+        // Walk the rest of the ranking, including the runner-up if it was never tried
+        size_t next = fired ? 2 : 1;
+        return execute(request, std::vector<size_t>(order.begin() + next, order.end()));
+    }
+    
+    void record_success(size_t index, std::chrono::milliseconds latency) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stats = endpoints_[index];
+        
+        double latency_ms = static_cast<double>(latency.count());
+        stats.ewma_latency_ms = stats.samples == 0
+            ? latency_ms
+            : alpha_ * latency_ms + (1.0 - alpha_) * stats.ewma_latency_ms;
+        stats.ewma_error_rate = (1.0 - alpha_) * stats.ewma_error_rate;
+        stats.samples++;
+        stats.consecutive_failures = 0;
+        
+        stats.recent[stats.recent_pos] = latency_ms;
+        stats.recent_pos = (stats.recent_pos + 1) % kLatencyWindow;
+        stats.recent_count = std::min(stats.recent_count + 1, kLatencyWindow);
+    }
+    
+    void record_failure(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stats = endpoints_[index];
+        
+        stats.ewma_error_rate = alpha_ + (1.0 - alpha_) * stats.ewma_error_rate;
+        stats.consecutive_failures++;
+        
+        if (stats.consecutive_failures >= kFailuresBeforeCooldown) {
+            auto cooldown = kBaseCooldown * (1 << std::min(stats.consecutive_failures - kFailuresBeforeCooldown, 4));
+            stats.cooldown_until = std::chrono::steady_clock::now() + std::min<std::chrono::steady_clock::duration>(cooldown, kMaxCooldown);
+            spdlog::warn("RPC endpoint {} failed {} times in a row, cooling down",
+                        stats.url, stats.consecutive_failures);
+        }
+    }
+    
+    std::optional<size_t> find(const std::string& url) const {
+        for (size_t i = 0; i < endpoints_.size(); ++i) {
+            if (endpoints_[i].url == url) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    std::vector<size_t> ranking() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        
+        std::vector<std::pair<double, size_t>> scored;
+        scored.reserve(endpoints_.size());
+        for (size_t i = 0; i < endpoints_.size(); ++i) {
+            scored.emplace_back(score(endpoints_[i], now), i);
+        }
+        std::stable_sort(scored.begin(), scored.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        
+        std::vector<size_t> order;
+        order.reserve(scored.size());
+        for (const auto& [score, index] : scored) {
+            order.push_back(index);
+        }
+        return order;
+    }
+    
+    const std::string& url(size_t index) const {
+        return endpoints_[index].url;
+    }
+    
+    size_t size() const {
+        return endpoints_.size();
+    }
+
+private:
+    struct EndpointStats {
+        std::string url;
+        double ewma_latency_ms = 0.0;
+        double ewma_error_rate = 0.0;
+        uint64_t samples = 0;
+        int consecutive_failures = 0;
+        std::chrono::steady_clock::time_point cooldown_until{};
+        std::array<double, kLatencyWindow> recent{};
+        size_t recent_pos = 0;
+        size_t recent_count = 0;
+    };
+    
+    // One hedged call's duplicate request; `fired` and `primary_done` settle
+    // which side owns it, `done` is set once a fired hedge has answered
+    struct Hedge {
+        size_t backup = 0;
+        RequestFunc request;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::optional<std::string> result;
+        bool primary_done = false;
+        bool fired = false;
+        bool done = false;
+    };
+    
+    struct Armed {
+        std::chrono::steady_clock::time_point due;
+        std::shared_ptr<Hedge> hedge;
+        
+        bool operator>(const Armed& other) const { return due > other.due; }
+    };
+    
+    // Lower is better. Untried endpoints score 0 so they get probed early.
+    static double score(const EndpointStats& stats, std::chrono::steady_clock::time_point now) {
+        if (stats.cooldown_until > now) {
+            return std::numeric_limits<double>::max();
+        }
+        return stats.ewma_latency_ms * (1.0 + 4.0 * stats.ewma_error_rate) + 1000.0 * stats.ewma_error_rate;
+    }
+    
+    std::optional<std::string> attempt(size_t index, const RequestFunc& request) {
+        auto start = std::chrono::steady_clock::now();
+        std::optional<std::string> body;
+        try {
+            body = request(endpoints_[index].url);
+        } catch (const std::exception& e) {
+            spdlog::warn("RPC request to {} threw: {}", endpoints_[index].url, e.what());
+        }
+        
+        if (body) {
+            record_success(index, std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start));
+        } else {
+            record_failure(index);
+        }
+        return body;
+    }
+    
+    void arm(std::chrono::steady_clock::time_point due, std::shared_ptr<Hedge> hedge) {
+        {
+            std::lock_guard<std::mutex> lock(hedges_mutex_);
+            armed_.push(Armed{due, std::move(hedge)});
+        }
+        timer_cv_.notify_one();
+    }
+    
+    // Fires each armed hedge whose primary is still out at its deadline
+    void timer_loop() {
+        std::unique_lock<std::mutex> lock(hedges_mutex_);
+        while (!stopping_) {
+            if (armed_.empty()) {
+                timer_cv_.wait(lock);
+                continue;
+            }
+            auto due = armed_.top().due;
+            if (std::chrono::steady_clock::now() < due) {
+                timer_cv_.wait_until(lock, due);
+                continue;
+            }
+            
+            auto hedge = armed_.top().hedge;
+            armed_.pop();
+            if (fired_.size() + busy_workers_ >= kHedgeWorkers || !hedge_allowed()) {
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> hedge_lock(hedge->mutex);
+                if (hedge->primary_done) {
+                    continue;
+                }
+                hedge->fired = true;
+            }
+            hedges_++;
+            fired_.push_back(std::move(hedge));
+            workers_cv_.notify_one();
+        }
+    }
+    
+    void worker_loop() {
+        std::unique_lock<std::mutex> lock(hedges_mutex_);
+        while (true) {
+            workers_cv_.wait(lock, [this] { return stopping_ || !fired_.empty(); });
+            if (fired_.empty()) {
+                return;
+            }
+            auto hedge = std::move(fired_.front());
+            fired_.pop_front();
+            busy_workers_++;
+            lock.unlock();
+            
+            auto body = attempt(hedge->backup, hedge->request);
+            {
+                std::lock_guard<std::mutex> hedge_lock(hedge->mutex);
+                hedge->result = std::move(body);
+                hedge->done = true;
+            }
+            hedge->cv.notify_all();
+            
+            lock.lock();
+            busy_workers_--;
+        }
+    }
+    
+    std::chrono::milliseconds hedge_delay(size_t index) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto& stats = endpoints_[index];
+        if (stats.recent_count < kMinSamplesForP95) {
+            return kDefaultHedgeDelay;
+        }
+        
+        std::vector<double> samples(stats.recent.begin(), stats.recent.begin() + stats.recent_count);
+        auto p95 = samples.begin() + static_cast<size_t>(0.95 * (samples.size() - 1));
+        std::nth_element(samples.begin(), p95, samples.end());
+        
+        return std::max(kMinHedgeDelay, std::chrono::milliseconds(static_cast<int64_t>(*p95)));
+    }
+    
+    bool hedge_allowed() const {
+        return static_cast<double>(hedges_.load()) < max_hedge_ratio_ * static_cast<double>(requests_.load());
+    }
+    
+    const double alpha_;
+    const double max_hedge_ratio_;
+    mutable std::mutex mutex_;
+    std::vector<EndpointStats> endpoints_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> hedges_{0};
+    
+    // Hedge timer and workers, all guarded by hedges_mutex_
+    std::mutex hedges_mutex_;
+    std::condition_variable timer_cv_;
+    std::condition_variable workers_cv_;
+    std::priority_queue<Armed, std::vector<Armed>, std::greater<Armed>> armed_;
+    std::deque<std::shared_ptr<Hedge>> fired_;
+    size_t busy_workers_ = 0;
+    bool stopping_ = false;
+    std::thread timer_;
+    std::vector<std::thread> workers_;
+};
+
+RpcEndpointManager::RpcEndpointManager(const std::vector<std::string>& urls, double ewma_alpha, double max_hedge_ratio)
+    : pImpl_(std::make_unique<Impl>(urls, ewma_alpha, max_hedge_ratio)) {}
+
+RpcEndpointManager::~RpcEndpointManager() = default;
+
+std::optional<std::string> RpcEndpointManager::execute(const RequestFunc& request) const {
+    return pImpl_->execute(request, pImpl_->ranking());
+}
+
+std::optional<std::string> RpcEndpointManager::execute_hedged(const RequestFunc& request) const {
+    return pImpl_->execute_hedged(request);
+}
+
+void RpcEndpointManager::record_success(const std::string& url, std::chrono::milliseconds latency) {
+    if (auto index = pImpl_->find(url)) {
+        pImpl_->record_success(*index, latency);
+    }
+}
+
+void RpcEndpointManager::record_failure(const std::string& url) {
+    if (auto index = pImpl_->find(url)) {
+        pImpl_->record_failure(*index);
+    }
+}
+
+std::vector<std::string> RpcEndpointManager::ranked_urls() const {
+    std::vector<std::string> urls;
+    for (size_t index : pImpl_->ranking()) {
+        urls.push_back(pImpl_->url(index));
+    }
+    return urls;
+}
+
+size_t RpcEndpointManager::size() const {
+    return pImpl_->size();
+}
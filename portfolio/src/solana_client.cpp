@@ -1,5 +1,6 @@
 #include "solana_client.hpp"
 #include "util.hpp"
+#include "rpc_endpoint_manager.hpp"
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
@@ -14,24 +15,15 @@ struct TokenAccount {
 
 class SolanaClient::Impl {
 public:
-    Impl(const Config& config) : config_(config) {
-        // Extract host and path from RPC URL
-        if (config_.solana_rpc_url.find("https://") == 0) {
-            auto url_without_protocol = config_.solana_rpc_url.substr(8);
-            auto slash_pos = url_without_protocol.find('/');
-            if (slash_pos != std::string::npos) {
-                rpc_host_ = url_without_protocol.substr(0, slash_pos);
-                rpc_path_ = url_without_protocol.substr(slash_pos);
-            } else {
-                rpc_host_ = url_without_protocol;
-                rpc_path_ = "/";
+    Impl(const Config& config) : config_(config), endpoints_(config.solana_rpc_urls) {
+        for (const auto& url : config_.solana_rpc_urls) {
+            if (url.find("https://") != 0 && url.find("http://") != 0) {
+                spdlog::error("Invalid Solana RPC URL format: {}", url);
+                throw std::runtime_error("Invalid Solana RPC URL");
             }
-        } else {
-            spdlog::error("Invalid Solana RPC URL format: {}", config_.solana_rpc_url);
-            throw std::runtime_error("Invalid Solana RPC URL");
         }
         
-        spdlog::info("Solana client configured for host: {}, path: {}", rpc_host_, rpc_path_);
+        spdlog::info("Solana client configured with {} RPC endpoint(s)", endpoints_.size());
     }
 
     std::vector<TokenAccount> get_token_accounts(const std::string& wallet_address) {
@@ -51,7 +43,7 @@ public:
                 }}
             };
 
-            auto response = make_rpc_call(rpc_request);
+            auto response = make_rpc_call(rpc_request, true);
             if (!response) {
                 return {};
             }
@@ -101,7 +93,7 @@ public:
                 {"params", {wallet_address, {{"commitment", "confirmed"}}}}
             };
 
-            auto response = make_rpc_call(rpc_request);
+            auto response = make_rpc_call(rpc_request, true);
             if (!response || !response->contains("result")) {
                 return 0.0;
             }
@@ -138,9 +130,30 @@ public:
     }
 
 private:
-    std::optional<nlohmann::json> make_rpc_call(const nlohmann::json& request) const {
+    // User-facing lookups are latency critical and get hedged across endpoints
+    std::optional<nlohmann::json> make_rpc_call(const nlohmann::json& request, bool latency_critical = false) const {
+        auto send = [body = request.dump()](const std::string& url) {
+            return post_rpc(url, body);
+        };
+        
+        auto response_text = latency_critical ? endpoints_.execute_hedged(send) : endpoints_.execute(send);
+        if (!response_text) {
+            spdlog::error("Solana RPC call failed on all endpoints");
+            return std::nullopt;
+        }
+        
+        return nlohmann::json::parse(*response_text);
+    }
+    
+    static std::optional<std::string> post_rpc(const std::string& url, const std::string& body) {
         try {
-            httplib::SSLClient client(rpc_host_);
+            // Split "https://host[:port]/path" into the client base and request path
+            auto host_start = url.find("://") + 3;
+            auto path_start = url.find('/', host_start);
+            std::string base = path_start == std::string::npos ? url : url.substr(0, path_start);
+            std::string path = path_start == std::string::npos ? "/" : url.substr(path_start);
+            
+            httplib::Client client(base);
             client.set_connection_timeout(10, 0);
             client.set_read_timeout(30, 0);
 
@@ -148,31 +161,30 @@ private:
                 {"Content-Type", "application/json"}
             };
 
-            auto response = client.Post(rpc_path_.c_str(), headers, request.dump(), "application/json");
+            auto response = client.Post(path.c_str(), headers, body, "application/json");
             
             if (!response || response->status != 200) {
-                spdlog::error("Solana RPC call failed with status: {}", response ? response->status : 0);
+                spdlog::warn("Solana RPC call to {} failed with status: {}", url, response ? response->status : 0);
                 return std::nullopt;
             }
 
             auto json_response = nlohmann::json::parse(response->body);
             
             if (json_response.contains("error")) {
-                spdlog::error("Solana RPC error: {}", json_response["error"].dump());
+                spdlog::warn("Solana RPC error from {}: {}", url, json_response["error"].dump());
                 return std::nullopt;
             }
 
-            return json_response;
+            return response->body;
 
         } catch (const std::exception& e) {
-            spdlog::error("Solana RPC call exception: {}", e.what());
+            spdlog::warn("Solana RPC call to {} threw: {}", url, e.what());
             return std::nullopt;
         }
     }
 
     Config config_;
-    std::string rpc_host_;
-    std::string rpc_path_;
+    RpcEndpointManager endpoints_;
 };
 
 // Public interface implementation
@@ -47,6 +47,8 @@ Config Config::from_env() {
     config.stream_rep = std::getenv("STREAM_REP") ? std::getenv("STREAM_REP") : "soul.cmd.replies";
     config.stream_alerts = std::getenv("STREAM_ALERTS") ? std::getenv("STREAM_ALERTS") : "soul.alerts";
     config.stream_audit = std::getenv("STREAM_AUDIT") ? std::getenv("STREAM_AUDIT") : "soul.audit";
+    config.stream_batch_size = std::getenv("STREAM_BATCH_SIZE") ? std::stoi(std::getenv("STREAM_BATCH_SIZE")) : 256;
+    config.stream_block_ms = std::getenv("STREAM_BLOCK_MS") ? std::stoi(std::getenv("STREAM_BLOCK_MS")) : 1000;
     config.service_name = std::getenv("SERVICE_NAME") ? std::getenv("SERVICE_NAME") : "tg_gateway";
     config.log_level = std::getenv("LOG_LEVEL") ? std::getenv("LOG_LEVEL") : "info";
     
@@ -65,4 +67,8 @@ void Config::validate() const {
     if (gateway_mode == "webhook" && webhook_public_url.empty()) {
         throw std::runtime_error("Webhook public URL required for webhook mode");
     }
+    
+    if (stream_batch_size < 1 || stream_block_ms < 1) {
+        throw std::runtime_error("Stream batch size and block timeout must be positive");
+    }
 }
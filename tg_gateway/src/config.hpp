@@ -18,6 +18,8 @@ struct Config {
     std::string stream_rep;
     std::string stream_alerts;
     std::string stream_audit;
+    int stream_batch_size;      // max entries per XREADGROUP
+    int stream_block_ms;        // max block while a stream is idle
     std::string service_name;
     std::string log_level;
 
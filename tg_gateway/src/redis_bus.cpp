@@ -3,6 +3,41 @@
 #include "util.hpp"
 #include <spdlog/spdlog.h>
 #include <chrono>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+
+using StreamAttrs = std::unordered_map<std::string, std::string>;
+using StreamItem = std::pair<std::string, StreamAttrs>;
+using StreamBatch = std::vector<StreamItem>;
+
+// One XREADGROUP for up to `count` new entries. A full batch means the
+// consumer is behind, so the next read skips BLOCK and drains the backlog;
+// otherwise it blocks for up to `block` waiting for new entries.
+StreamBatch read_batch(sw::redis::Redis& redis, const std::string& group, const std::string& consumer,
+                       const std::string& stream, long long count, std::chrono::milliseconds block,
+                       bool backlog) {
+    std::unordered_map<std::string, StreamBatch> result;
+    if (backlog) {
+        redis.xreadgroup(group, consumer, stream, ">", count, std::inserter(result, result.end()));
+    } else {
+        redis.xreadgroup(group, consumer, stream, ">", block, count, std::inserter(result, result.end()));
+    }
+    
+    auto it = result.find(stream);
+    return it == result.end() ? StreamBatch{} : std::move(it->second);
+}
+
+// Single multi-ID XACK for a processed batch
+void ack_batch(sw::redis::Redis& redis, const std::string& stream, const std::string& group,
+               const std::vector<std::string>& ids) {
+    if (!ids.empty()) {
+        redis.xack(stream, group, ids.begin(), ids.end());
+    }
+}
+
+} // namespace
 
 RedisBus::RedisBus(const Config& config) : config_(config), running_(false) {}
 
@@ -142,28 +177,36 @@ void RedisBus::reply_consumer_loop(std::function<void(const CommandReply&)> call
         // Group might already exist
     }
     
+    bool backlog = false;
+    std::vector<std::string> acked;
+    
     while (running_) {
         try {
-            auto result = redis_->xreadgroup(consumer_group, consumer_name, 
-                {{config_.stream_rep, ">"}}, std::chrono::milliseconds(1000));
+            auto entries = read_batch(*redis_, consumer_group, consumer_name, config_.stream_rep,
+                                      config_.stream_batch_size,
+                                      std::chrono::milliseconds(config_.stream_block_ms), backlog);
+            backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
             
-            for (const auto& stream : result) {
-                for (const auto& message : stream.second) {
-                    try {
-                        auto data_it = message.second.find("data");
-                        if (data_it != message.second.end()) {
-                            auto json = nlohmann::json::parse(data_it->second);
-                            auto reply = CommandReply::from_json(json);
-                            callback(reply);
-                            
-                            redis_->xack(config_.stream_rep, consumer_group, {message.first});
-                        }
-                    } catch (const std::exception& e) {
-                        spdlog::error("Failed to process reply message: {}", e.what());
+            acked.clear();
+            for (const auto& message : entries) {
+                try {
+                    auto data_it = message.second.find("data");
+                    if (data_it != message.second.end()) {
+                        auto json = nlohmann::json::parse(data_it->second);
+                        auto reply = CommandReply::from_json(json);
+                        callback(reply);
+                        
+                        acked.push_back(message.first);
                     }
+                } catch (const std::exception& e) {
+                    spdlog::error("Failed to process reply message: {}", e.what());
                 }
             }
+            
+            // Acknowledge the whole batch in one round trip
+            ack_batch(*redis_, config_.stream_rep, consumer_group, acked);
         } catch (const std::exception& e) {
+            backlog = false;
             if (running_) {
                 spdlog::error("Reply consumer error: {}", e.what());
                 std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -182,28 +225,36 @@ void RedisBus::alert_consumer_loop(std::function<void(const Alert&)> callback) {
         // Group might already exist
     }
     
+    bool backlog = false;
+    std::vector<std::string> acked;
+    
     while (running_) {
         try {
-            auto result = redis_->xreadgroup(consumer_group, consumer_name,
-                {{config_.stream_alerts, ">"}}, std::chrono::milliseconds(1000));
+            auto entries = read_batch(*redis_, consumer_group, consumer_name, config_.stream_alerts,
+                                      config_.stream_batch_size,
+                                      std::chrono::milliseconds(config_.stream_block_ms), backlog);
+            backlog = entries.size() >= static_cast<size_t>(config_.stream_batch_size);
             
-            for (const auto& stream : result) {
-                for (const auto& message : stream.second) {
-                    try {
-                        auto data_it = message.second.find("data");
-                        if (data_it != message.second.end()) {
-                            auto json = nlohmann::json::parse(data_it->second);
-                            auto alert = Alert::from_json(json);
-                            callback(alert);
-                            
-                            redis_->xack(config_.stream_alerts, consumer_group, {message.first});
-                        }
-                    } catch (const std::exception& e) {
-                        spdlog::error("Failed to process alert message: {}", e.what());
+            acked.clear();
+            for (const auto& message : entries) {
+                try {
+                    auto data_it = message.second.find("data");
+                    if (data_it != message.second.end()) {
+                        auto json = nlohmann::json::parse(data_it->second);
+                        auto alert = Alert::from_json(json);
+                        callback(alert);
+                        
+                        acked.push_back(message.first);
                     }
+                } catch (const std::exception& e) {
+                    spdlog::error("Failed to process alert message: {}", e.what());
                 }
             }
+            
+            // Acknowledge the whole batch in one round trip
+            ack_batch(*redis_, config_.stream_alerts, consumer_group, acked);
         } catch (const std::exception& e) {
+            backlog = false;
             if (running_) {
                 spdlog::error("Alert consumer error: {}", e.what());
                 std::this_thread::sleep_for(std::chrono::seconds(5));